@@ -1,11 +1,17 @@
 import { NextResponse } from 'next/server';
-import { exec, spawn } from 'child_process';
-import fs from 'fs';
+import { exec, spawn, ChildProcessWithoutNullStreams } from 'child_process';
+import os from 'os';
 import path from 'path';
+import readline from 'readline';
+import { createHash } from 'crypto';
 
 const BACKEND_DIR = path.join(process.cwd(), 'backend');
-const INPUT_FILE = path.join(BACKEND_DIR, 'temp_input.txt');
 const EXECUTABLE = path.join(BACKEND_DIR, 'ordonnanceur');
+const POOL_SIZE = Math.max(1, Math.min(4, os.cpus().length));
+const REQUEST_TIMEOUT_MS = 10000;
+const RESULT_CACHE_SIZE = 32;
+// Optional on-disk cache shared by all workers, relative to backend/ (e.g. "cache")
+const DISK_CACHE_DIR = process.env.SIMULATION_CACHE_DIR;
 
 const compileBackend = () => {
   return new Promise((resolve, reject) => {
@@ -20,12 +26,152 @@ const compileBackend = () => {
   });
 };
 
+// make is incremental: run it once per server process so a stale binary
+// never answers requests in an output format it does not know yet.
+let backendReady: Promise<unknown> | null = null;
+const ensureBackend = () => {
+  if (!backendReady) {
+    backendReady = compileBackend().catch(error => {
+      backendReady = null;
+      throw error;
+    });
+  }
+  return backendReady;
+};
+
+interface Pending {
+  resolve: (doc: any) => void;
+  reject: (error: Error) => void;
+  timer: NodeJS.Timeout;
+}
+
+// A long-running `ordonnanceur --serve` process answering one JSON line per request.
+class Worker {
+  private child: ChildProcessWithoutNullStreams;
+  private pending = new Map<string, Pending>();
+  alive = true;
+
+  constructor() {
+    const args = DISK_CACHE_DIR ? ['--serve', `--cache-dir=${DISK_CACHE_DIR}`] : ['--serve'];
+    this.child = spawn(EXECUTABLE, args, { cwd: BACKEND_DIR });
+    readline.createInterface({ input: this.child.stdout }).on('line', line => this.onLine(line));
+    this.child.stderr.on('data', data => console.error("C program stderr:", data.toString()));
+    this.child.on('exit', code => this.fail(new Error(`Backend worker exited with code: ${code}`)));
+    this.child.on('error', error => this.fail(new Error(`Failed to start backend: ${error.message}`)));
+    // A worker that died before the write gets EPIPE here instead of crashing the server
+    this.child.stdin.on('error', error => this.fail(new Error(`Backend worker unreachable: ${error.message}`)));
+  }
+
+  get load() {
+    return this.pending.size;
+  }
+
+  send(id: string, frame: string) {
+    return new Promise<any>((resolve, reject) => {
+      if (!this.alive) {
+        reject(new Error('Backend worker is no longer running'));
+        return;
+      }
+      const timer = setTimeout(() => {
+        this.pending.delete(id);
+        reject(new Error(`Backend timeout after ${REQUEST_TIMEOUT_MS / 1000} seconds`));
+        this.retire();
+      }, REQUEST_TIMEOUT_MS);
+      this.pending.set(id, { resolve, reject, timer });
+      this.child.stdin.write(frame);
+    });
+  }
+
+  private onLine(line: string) {
+    let doc: any;
+    try {
+      doc = JSON.parse(line);
+    } catch (error) {
+      console.error("Unreadable backend reply:", line);
+      return;
+    }
+    const entry = this.pending.get(doc.id);
+    if (!entry) return;
+    this.pending.delete(doc.id);
+    clearTimeout(entry.timer);
+    if (doc.error) entry.reject(new Error(`Backend error: ${doc.error}`));
+    else entry.resolve(doc);
+    if (!this.alive && this.pending.size === 0) this.child.kill();
+  }
+
+  // A worker stuck on a request gets no new ones; it is killed once the requests
+  // already sent to it have been answered or have timed out in turn.
+  private retire() {
+    this.alive = false;
+    if (this.pending.size === 0) this.child.kill();
+  }
+
+  private fail(error: Error) {
+    this.alive = false;
+    this.pending.forEach(entry => {
+      clearTimeout(entry.timer);
+      entry.reject(error);
+    });
+    this.pending.clear();
+  }
+}
+
+const workers: Worker[] = [];
+let nextRequestId = 0;
+
+function pickWorker() {
+  for (let i = workers.length - 1; i >= 0; i--) {
+    if (!workers[i].alive) workers.splice(i, 1);
+  }
+  while (workers.length < POOL_SIZE) workers.push(new Worker());
+  return workers.reduce((best, w) => (w.load < best.load ? w : best));
+}
+
+// I/O bursts follow the priority as "IO CPU" pairs; IO is LEN or LEN@DEVICE.
+const IO_PAIRS = /^(\d+(@\d+)?\s+\d+)(\s+\d+(@\d+)?\s+\d+)*$/;
+
+function normalizeProcesses(processes: any[]) {
+  return processes.map((p: any) => {
+    const name = String(p.name).trim().replace(/\s+/g, '_') || 'P';
+    const io = typeof p.io === 'string' ? p.io.trim().replace(/\s+/g, ' ') : '';
+    const line = `${name} ${Math.trunc(Number(p.arrival))} ${Math.trunc(Number(p.burst))} ${Math.trunc(Number(p.priority))}`;
+    return IO_PAIRS.test(io) ? `${line} ${io}` : line;
+  });
+}
+
+function buildFrame(id: string, lines: string[], algorithms: number[], quantum: number) {
+  return `SIMULATE ${id} ${lines.length} ${quantum} ${algorithms.join(',')}\n${lines.join('\n')}\n`;
+}
+
+// Decoded results of the last requests, keyed by the normalized request content.
+// The backend keeps its own per-policy cache; this one also skips the round trip.
+const resultCache = new Map<string, any[]>();
+
+function cacheKey(lines: string[], algorithms: number[], quantum: number) {
+  return createHash('sha256').update(`${quantum} ${algorithms.join(',')}\n${lines.join('\n')}`).digest('hex');
+}
+
+function rememberResults(key: string, results: any[]) {
+  resultCache.delete(key);
+  resultCache.set(key, results);
+  if (resultCache.size > RESULT_CACHE_SIZE) {
+    resultCache.delete(resultCache.keys().next().value as string);
+  }
+}
+
 export async function POST(req: Request) {
-  console.log("=== API CALL STARTED ===");
-  
   try {
     const body = await req.json();
     const { processes, algorithms, quantum } = body;
+    const q = quantum || 2;
+
+    // The header is one line of integers: anything else would desynchronize the worker
+    if (!Array.isArray(algorithms) || algorithms.length === 0 || !algorithms.every(a => Number.isInteger(a))) {
+      return NextResponse.json({ error: 'algorithms must be a non-empty array of integers' }, { status: 400 });
+    }
+    if (!Number.isInteger(q) || q <= 0) {
+      return NextResponse.json({ error: 'quantum must be a positive integer' }, { status: 400 });
+    }
 
     console.log("Received request:", {
       processCount: processes.length,
@@ -33,96 +179,26 @@ export async function POST(req: Request) {
       quantum
     });
 
-    const fileContent = processes
-      .map((p: any) => `${p.name} ${p.arrival} ${p.burst} ${p.priority}`)
-      .join('\n');
-    
-    console.log("Writing to input file:", fileContent);
-    fs.writeFileSync(INPUT_FILE, fileContent);
-
-    if (!fs.existsSync(EXECUTABLE)) {
-      console.log("Executable not found, compiling...");
-      await compileBackend();
-    } else {
-      console.log("Executable found at:", EXECUTABLE);
+    const lines = normalizeProcesses(processes);
+    const key = cacheKey(lines, algorithms, q);
+    const cached = resultCache.get(key);
+    if (cached) {
+      rememberResults(key, cached);
+      return NextResponse.json({ results: cached });
     }
 
-    let inputString = algorithms.join(' ') + '\n';
-    if (algorithms.includes(2) || algorithms.includes(4)) {
-      inputString += `${quantum || 2}\n`;
-    }
-    
-    console.log("Sending to C program:", JSON.stringify(inputString));
-
-    const child = spawn(EXECUTABLE, ['temp_input.txt'], { cwd: BACKEND_DIR });
-    
-    let outputData = '';
-    let errorData = '';
-    
-    child.stdin.write(inputString);
-    child.stdin.end();
-
-    child.stdout.on('data', (data) => {
-      outputData += data.toString();
-    });
-    
-    child.stderr.on('data', (data) => {
-      errorData += data.toString();
-      console.error("C program stderr:", data.toString());
-    });
+    await ensureBackend();
 
-    return new Promise((resolve, reject) => {
-      child.on('close', (code) => {
-        console.log(`C process exited with code: ${code}`);
-        console.log("Output length:", outputData.length);
-        
-        if (errorData) {
-          console.error("C program errors:", errorData);
-        }
-        
-        if (code !== 0) {
-          console.error(`C program failed with exit code: ${code}`);
-          reject(new Error(`Backend simulation failed with code: ${code}`));
-          return;
-        }
-        
-        if (!outputData || outputData.trim().length === 0) {
-          console.error("C program returned no output");
-          reject(new Error("Backend returned no output"));
-          return;
-        }
-        
-        fs.writeFileSync(path.join(BACKEND_DIR, 'debug_output.txt'), outputData);
-        console.log("Raw output saved to debug_output.txt");
-        
-        try {
-          const results = parseCOutput(outputData, algorithms, quantum);
-          console.log("Parsed", results.length, "algorithms");
-          
-          if (!results || results.length === 0) {
-            console.error("Parser returned no results");
-            reject(new Error("Failed to parse backend output"));
-            return;
-          }
-          
-          resolve(NextResponse.json({ results }));
-        } catch (parseError) {
-          console.error("Parse error:", parseError);
-          reject(new Error(`Failed to parse output: ${parseError}`));
-        }
-      });
-      
-      child.on('error', (error) => {
-        console.error("Failed to spawn C process:", error);
-        reject(new Error(`Failed to start backend: ${error.message}`));
-      });
-      
-      setTimeout(() => {
-        child.kill();
-        reject(new Error("Backend process timeout after 10 seconds"));
-      }, 10000);
-    });
+    const id = `r${nextRequestId++}`;
+    const doc = await pickWorker().send(id, buildFrame(id, lines, algorithms, q));
+    const results = decodeResults(doc, q);
+
+    if (!results || results.length === 0) {
+      throw new Error("Backend returned no results");
+    }
 
+    rememberResults(key, results);
+    return NextResponse.json({ results });
   } catch (error) {
     console.error("API Error:", error);
     return NextResponse.json({ 
@@ -132,312 +208,94 @@ export async function POST(req: Request) {
   }
 }
 
-function parseCOutput(raw: string, selectedAlgos: number[], quantum: number) {
-  const cleanRaw = raw.replace(/\x1B\[[0-9;]*[mK]/g, '');
-  const lines = cleanRaw.split('\n');
-  
-  console.log("Parsing", lines.length, "lines of output");
-  console.log("First 10 lines for debugging:");
-  lines.slice(0, 10).forEach((line, i) => {
-    console.log(`[${i}] "${line}"`);
-  });
-  
-  const parsedResults: any[] = [];
-  let currentAlgo: any = null;
-  let inGanttSection = false;
-  let inTimelineSection = false;
-  let isMultilevel = false;
-  let ganttLines: string[] = [];
-  let timelineLines: string[] = [];
-
-  lines.forEach((line, lineIndex) => {
-    const cleanLine = line.trim();
-    
-    const lineLower = cleanLine.toLowerCase();
-    if (lineLower.includes('multi-level') || lineLower.includes('multilevel')) {
-      isMultilevel = true;
-    } else if (lineLower.includes('fifo') || lineLower.includes('round robin') || 
-               lineLower.includes('sjf') || lineLower.includes('srtf') || 
-               lineLower.includes('priority')) {
-      isMultilevel = false;
-    }
-    
-    if ((cleanLine.includes('===') && (cleanLine.includes('Algorithm') || cleanLine.includes('Scheduler') || 
-         cleanLine.includes('Priority') || cleanLine.includes('FIFO') || 
-         cleanLine.includes('Round') || cleanLine.includes('SJF') || 
-         cleanLine.includes('SRTF') || cleanLine.includes('avec aging'))) ||
-        (cleanLine.includes('avec aging') && cleanLine.includes('Quantum'))) {
-      
-      if (currentAlgo) {
-        if (ganttLines.length > 0) {
-          processGanttLines(currentAlgo, ganttLines);
-          ganttLines = [];
-        }
-        if (isMultilevel && timelineLines.length > 0) {
-          processTimelineLines(currentAlgo, timelineLines);
-          timelineLines = [];
-        }
-        if (currentAlgo.timeline.length > 0) {
-          parsedResults.push(currentAlgo);
-          console.log(`Added algorithm: ${currentAlgo.name} (isMultilevel: ${isMultilevel})`);
-        }
-      }
-      
-      let name = "Unknown";
-      
-      if (lineLower.includes('fifo') || lineLower.includes('first in first out')) {
-        name = "FIFO (First In First Out)";
-        isMultilevel = false;
-      } else if (lineLower.includes('round robin')) {
-        name = `Round Robin (Quantum=${quantum})`;
-        isMultilevel = false;
-      } else if (lineLower.includes('sjf') || lineLower.includes('shortest job first')) {
-        name = "SJF (Shortest Job First)";
-        isMultilevel = false;
-      } else if (lineLower.includes('srtf') || lineLower.includes('shortest remaining time first')) {
-        name = "SRTF (Shortest Remaining Time First)";
-        isMultilevel = false;
-      } else if (lineLower.includes('priority preemptive')) {
-        name = "Preemptive Priority";
-        isMultilevel = false;
-      } else if (lineLower.includes('priority non-preemptive') || lineLower.includes('non-preemptive priority')) {
-        name = "Non-preemptive Priority";
-        isMultilevel = false;
-      } else if (lineLower.includes('multi-level') || lineLower.includes('multilevel') || 
-                 lineLower.includes('avec aging') || lineLower.includes('level') && lineLower.includes('aging')) {
-        name = `Multi-Level avec aging (Quantum=${quantum})`;
-        isMultilevel = true;
-      } else {
-        const match = cleanLine.match(/===\s*(.+?)\s*===/);
-        if (match) {
-          name = match[1].trim();
-        } else {
-          name = cleanLine.replace(/===/g, '').replace('Algorithm', '').replace('Scheduler', '').trim();
-        }
-      }
+const ALGORITHM_LABELS: Record<number, (quantum: number) => string> = {
+  1: () => "FIFO (First In First Out)",
+  2: (q) => `Round Robin (Quantum=${q})`,
+  3: () => "Preemptive Priority",
+  4: (q) => `Multi-Level avec aging (Quantum=${q})`,
+  5: () => "SJF (Shortest Job First)",
+  6: () => "Non-preemptive Priority",
+  7: () => "SRTF (Shortest Remaining Time First)",
+  8: (q) => `CFS (Completely Fair Scheduler, granularity=${q})`,
+  9: (q) => `MLFQ (Multilevel Feedback Queue, Quantum=${q})`,
+  10: (q) => `Lottery (Quantum=${q})`,
+  11: (q) => `Stride (Quantum=${q})`,
+};
 
-      console.log(`Detected algorithm: ${name} (isMultilevel: ${isMultilevel})`);
-      currentAlgo = { 
-        name, 
-        timeline: [],
-        levelTimeline: isMultilevel ? {} : undefined,
-        isMultilevel
-      };
-      inGanttSection = false;
-      inTimelineSection = false;
-      ganttLines = [];
-      timelineLines = [];
-    }
-    
-    if (!currentAlgo) return;
-    
-    if (cleanLine.includes('Gantt Chart:') || cleanLine.includes('Gantt Chart (Time')) {
-      inGanttSection = true;
-      inTimelineSection = false;
-      console.log(`Entered Gantt section for ${currentAlgo.name}`);
-    }
-    
-    if (cleanLine.includes('Timeline by Level:')) {
-      inTimelineSection = true;
-      inGanttSection = false;
-      console.log(`Entered Timeline by Level section for multilevel`);
-    }
-    
-    if (inGanttSection && cleanLine.includes(':') && 
-        (cleanLine.includes('█') || cleanLine.includes('.') || /P\d+/.test(cleanLine))) {
-      ganttLines.push(cleanLine);
-    }
-    
-    if (currentAlgo.isMultilevel && inTimelineSection && (cleanLine.includes('Level') || cleanLine.includes('Time'))) {
-      timelineLines.push(cleanLine);
-    }
-    
-    if (cleanLine.includes('Summary:') || cleanLine.includes('End of') || 
-        cleanLine.includes('================================')) {
-      inGanttSection = false;
-      inTimelineSection = false;
-    }
-  });
-  
-  if (currentAlgo) {
-    if (ganttLines.length > 0) {
-      processGanttLines(currentAlgo, ganttLines);
-    }
-    if (currentAlgo.isMultilevel && timelineLines.length > 0) {
-      processTimelineLines(currentAlgo, timelineLines);
-    }
-    
-    if (currentAlgo.timeline.length > 0) {
-      parsedResults.push(currentAlgo);
-      console.log(`Added final algorithm: ${currentAlgo.name}`);
-    }
-  }
-  
-  parsedResults.forEach(algo => {
-    if (algo.timeline.length > 0) {
-      const merged: any[] = [];
-      algo.timeline.sort((a: any, b: any) => a.startTime - b.startTime);
-      
-      algo.timeline.forEach((block: any) => {
-        const lastBlock = merged[merged.length - 1];
-        if (lastBlock && lastBlock.process === block.process && 
-            lastBlock.startTime + lastBlock.duration === block.startTime) {
-          lastBlock.duration += block.duration;
-        } else {
-          merged.push({...block});
-        }
-      });
-      
-      algo.timeline = merged;
-    }
-  });
-  
-  console.log("Parsing complete. Found", parsedResults.length, "algorithms");
-  parsedResults.forEach((algo, idx) => {
-    console.log(`  [${idx}] ${algo.name} (multilevel: ${algo.isMultilevel})`);
-    if (algo.isMultilevel && algo.levelTimeline) {
-      console.log(`      Has level timeline: ${Object.keys(algo.levelTimeline).length > 0}`);
-    }
-  });
-  
-  return parsedResults;
+// Only Multi-Level avec aging maps onto the two-row level view; MLFQ levels stay in the Gantt chart.
+const TWO_LEVEL_ALGORITHM = 4;
+
+interface BackendSegment {
+  pid: number;
+  process: string;
+  start: number;
+  end: number;
+  level: number;
 }
 
-function processGanttLines(algo: any, ganttLines: string[]) {
-  console.log(`Processing ${ganttLines.length} Gantt lines for ${algo.name}`);
-  
-  ganttLines.forEach(line => {
-    if (!line.includes(':') || line.includes('Time :')) return;
-    
-    const parts = line.split(':');
-    const processName = parts[0].trim();
-    const ganttStr = parts.slice(1).join(':').trim();
-    
-    let time = 0;
-    let inBlock = false;
-    let blockStart = 0;
-    
-    for (let i = 0; i < ganttStr.length; i++) {
-      const char = ganttStr[i];
-      
-      if (char === '█' || char === '#' || char === 'X' || char === '■' || char === '|') {
-        if (!inBlock) {
-          inBlock = true;
-          blockStart = time;
-        }
-        time++;
-      } else if (char === '.' || char === ' ' || char === '-') {
-        if (inBlock) {
-          const duration = time - blockStart;
-          if (duration > 0) {
-            algo.timeline.push({
-              process: processName,
-              startTime: blockStart,
-              duration: duration
-            });
-          }
-          inBlock = false;
-        }
-        time++;
-      } else {
-        if (inBlock) {
-          const duration = time - blockStart;
-          if (duration > 0) {
-            algo.timeline.push({
-              process: processName,
-              startTime: blockStart,
-              duration: duration
-            });
-          }
-          inBlock = false;
-        }
-        time++;
-      }
-    }
-    
-    if (inBlock) {
-      const duration = time - blockStart;
-      if (duration > 0) {
-        algo.timeline.push({
-          process: processName,
-          startTime: blockStart,
-          duration: duration
-        });
-      }
+interface BackendResult {
+  id: number;
+  name: string;
+  quantum?: number;
+  makespan: number;
+  error?: string;
+  segments: BackendSegment[];
+  processes: {
+    pid: number;
+    name: string;
+    arrival: number;
+    burst: number;
+    priority: number;
+    finish: number;
+    waiting: number;
+    turnaround: number;
+    response: number;
+  }[];
+  averages: { waiting: number; turnaround: number; response: number };
+}
+
+function toTimeline(segments: BackendSegment[]) {
+  const timeline: { process: string; startTime: number; duration: number }[] = [];
+  segments.forEach(seg => {
+    const last = timeline[timeline.length - 1];
+    if (last && last.process === seg.process && last.startTime + last.duration === seg.start) {
+      last.duration += seg.end - seg.start;
+    } else {
+      timeline.push({ process: seg.process, startTime: seg.start, duration: seg.end - seg.start });
     }
   });
+  return timeline;
 }
 
-function processTimelineLines(algo: any, timelineLines: string[]) {
-  console.log(`Processing timeline lines for multilevel`);
-  
-  console.log("=== TIMELINE LINES ===");
-  timelineLines.forEach((line, idx) => console.log(`[${idx}] "${line}"`));
-  console.log("=== END TIMELINE LINES ===");
-  
-  let timeScale: number[] = [];
-  let level1Data: { time: number; process: string }[] = [];
-  let level2Data: { time: number; process: string }[] = [];
-  
-  const timeLine = timelineLines.find(line => 
-    line.trim().startsWith('Time') || line.includes('Time :')
-  );
-  
-  if (timeLine) {
-    console.log("Found time line:", timeLine);
-    
-    const timeMatch = timeLine.match(/\d+/g);
-    if (timeMatch) {
-      timeScale = timeMatch.map(Number);
-      console.log("Time scale:", timeScale);
-    }
-  }
-  
-  timelineLines.forEach(line => {
-    const cleanLine = line.trim();
-    
-    if (cleanLine.startsWith('Level 1') || cleanLine.includes('Level 1:')) {
-      console.log("Processing Level 1 line:", cleanLine);
-      
-      const dataPart = cleanLine.replace(/Level 1:?\s*/, '');
-      const items = dataPart.split(/\s+/);
-      
-      items.forEach((item, idx) => {
-        if (item && item !== '--' && item !== '----' && item !== '....') {
-          const time = idx < timeScale.length ? timeScale[idx] : idx;
-          level1Data.push({ time, process: item });
-        }
-      });
-    }
-    
-    if (cleanLine.startsWith('Level 2') || cleanLine.includes('Level 2:')) {
-      console.log("Processing Level 2 line:", cleanLine);
-      
-      const dataPart = cleanLine.replace(/Level 2:?\s*/, '');
-      const items = dataPart.split(/\s+/);
-      
-      items.forEach((item, idx) => {
-        if (item && item !== '--' && item !== '----' && item !== '....') {
-          const time = idx < timeScale.length ? timeScale[idx] : idx;
-          level2Data.push({ time, process: item });
-        }
-      });
+function toLevelTimeline(segments: BackendSegment[], makespan: number) {
+  const level1: { time: number; process: string }[] = [];
+  const level2: { time: number; process: string }[] = [];
+  segments.forEach(seg => {
+    const target = seg.level === 1 ? level1 : level2;
+    for (let t = seg.start; t < seg.end; t++) {
+      target.push({ time: t, process: seg.process });
     }
   });
-  
-  if (timeScale.length === 0) {
-    const allTimes = [...level1Data.map(d => d.time), ...level2Data.map(d => d.time)];
-    const maxTime = allTimes.length > 0 ? Math.max(...allTimes) : 0;
-    timeScale = Array.from({ length: maxTime + 1 }, (_, i) => i);
-  }
-  
-  console.log(`Parsed: Level 1 = ${level1Data.length} entries, Level 2 = ${level2Data.length} entries`);
-  console.log("Level 1:", level1Data);
-  console.log("Level 2:", level2Data);
-  
-  algo.levelTimeline = {
-    level1: level1Data,
-    level2: level2Data,
-    timeScale: timeScale
+  return {
+    level1,
+    level2,
+    timeScale: Array.from({ length: makespan }, (_, i) => i),
   };
-}
\ No newline at end of file
+}
+
+function decodeResults(doc: { results: BackendResult[] }, quantum: number) {
+  return doc.results
+    .filter(result => !result.error)
+    .map(result => {
+      const isMultilevel = result.id === TWO_LEVEL_ALGORITHM && result.segments.some(seg => seg.level > 0);
+      const label = ALGORITHM_LABELS[result.id];
+      return {
+        name: label ? label(result.quantum ?? quantum) : result.name,
+        timeline: toTimeline(result.segments),
+        levelTimeline: isMultilevel ? toLevelTimeline(result.segments, result.makespan) : undefined,
+        isMultilevel,
+        processes: result.processes,
+        averages: result.averages,
+      };
+    });
+}
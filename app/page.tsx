@@ -8,6 +8,8 @@ type Process = {
   arrival: number;
   burst: number;
   priority: number;
+  // Optional "IO CPU" pairs from an uploaded trace, e.g. "4@1 2 3 5"
+  io?: string;
 };
 
 type ResultData = {
@@ -48,7 +50,8 @@ export default function OperatingSystemSchedulers() {
             name: parts[0],
             arrival: parseInt(parts[1]),
             burst: parseInt(parts[2]),
-            priority: parseInt(parts[3])
+            priority: parseInt(parts[3]),
+            io: parts.slice(4).join(' ') || undefined
           });
         }
       });
@@ -293,9 +296,25 @@ export default function OperatingSystemSchedulers() {
                         <input type="checkbox" checked={selectedSchedulers.includes(4)} onChange={() => toggleScheduler(4)} className="w-5 h-5 rounded text-blue-600 focus:ring-orange-500" />
                         <span className="font-medium">Multi-Level avec aging</span>
                       </label>
+                      <label className="flex items-center gap-3 cursor-pointer p-2 hover:bg-orange-100/50 rounded transition">
+                        <input type="checkbox" checked={selectedSchedulers.includes(8)} onChange={() => toggleScheduler(8)} className="w-5 h-5 rounded text-blue-600 focus:ring-orange-500" />
+                        <span className="font-medium">CFS (Completely Fair Scheduler)</span>
+                      </label>
+                      <label className="flex items-center gap-3 cursor-pointer p-2 hover:bg-orange-100/50 rounded transition">
+                        <input type="checkbox" checked={selectedSchedulers.includes(9)} onChange={() => toggleScheduler(9)} className="w-5 h-5 rounded text-blue-600 focus:ring-orange-500" />
+                        <span className="font-medium">MLFQ (Multilevel Feedback Queue)</span>
+                      </label>
+                      <label className="flex items-center gap-3 cursor-pointer p-2 hover:bg-orange-100/50 rounded transition">
+                        <input type="checkbox" checked={selectedSchedulers.includes(10)} onChange={() => toggleScheduler(10)} className="w-5 h-5 rounded text-blue-600 focus:ring-orange-500" />
+                        <span className="font-medium">Lottery</span>
+                      </label>
+                      <label className="flex items-center gap-3 cursor-pointer p-2 hover:bg-orange-100/50 rounded transition">
+                        <input type="checkbox" checked={selectedSchedulers.includes(11)} onChange={() => toggleScheduler(11)} className="w-5 h-5 rounded text-blue-600 focus:ring-orange-500" />
+                        <span className="font-medium">Stride</span>
+                      </label>
                     </div>
 
-                    {(selectedSchedulers.includes(2) || selectedSchedulers.includes(4)) && (
+                    {(selectedSchedulers.includes(2) || selectedSchedulers.includes(4) || selectedSchedulers.includes(8) || selectedSchedulers.includes(9) || selectedSchedulers.includes(10) || selectedSchedulers.includes(11)) && (
                        <div className="mt-4 pt-4 border-t border-orange-200">
                           <label className="text-sm font-bold text-slate-700 block mb-1">Time Quantum</label>
                           <input type="number" value={quantum} onChange={(e) => setQuantum(parseInt(e.target.value))} className="border rounded p-2 w-24" />
@@ -0,0 +1,29 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <stddef.h>
+
+// Allocateur par blocs : on empile, puis on libère tout d'un coup (reset)
+typedef struct ArenaChunk {
+    struct ArenaChunk *prev;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaChunk;
+
+typedef struct {
+    ArenaChunk *head;
+} Arena;
+
+typedef struct {
+    ArenaChunk *chunk;
+    size_t used;
+} ArenaMark;
+
+int  arena_init(Arena *a, size_t size);
+void *arena_alloc(Arena *a, size_t size);
+void *arena_calloc(Arena *a, size_t count, size_t size);
+ArenaMark arena_mark(Arena *a);
+void arena_reset(Arena *a, ArenaMark m);
+void arena_free(Arena *a);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+#include <stdint.h>
+#include "arena.h"
+
+#define BITMAP_MAX_DEPTH 4   // 64^4 = 16 M bits
+
+/*
+ * Bitmap hiérarchique : un bit de la couche k+1 dit si le mot correspondant
+ * de la couche k est non nul. Le premier bit posé se trouve en descendant
+ * une fois par couche, soit O(1) pour un nombre de bits borné.
+ */
+typedef struct {
+    uint64_t *word[BITMAP_MAX_DEPTH];
+    int words[BITMAP_MAX_DEPTH];
+    int depth;
+} Bitmap;
+
+int  bitmap_init(Bitmap *b, int bits, Arena *a);   // 0 si trop de bits ou plus de mémoire
+void bitmap_set(Bitmap *b, int i);
+void bitmap_clear(Bitmap *b, int i);
+int  bitmap_first(const Bitmap *b);                // -1 si vide
+int  bitmap_last(const Bitmap *b);                 // -1 si vide
+int  bitmap_next(const Bitmap *b, int from);       // premier bit posé >= from, -1 sinon
+
+#endif
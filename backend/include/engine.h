@@ -0,0 +1,244 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+#include <limits.h>
+#include "process.h"
+#include "arena.h"
+#include "heap.h"
+#include "schedule.h"
+#include "profile.h"
+
+typedef struct Engine Engine;
+typedef struct Stream Stream;
+
+#define DEFAULT_LEVELS 8     // niveaux de la file multiniveau à retour
+#define MAX_LEVELS (1 << 20)
+#define DEFAULT_SEED 1       // graine du générateur (loterie)
+#define CP_EVENTS 256        // événements au moins entre deux points de reprise en pleine charge
+#define CP_SCAN   4          // et au moins un par CP_SCAN processus que l'image parcourt
+#define CP_IMAGES 2          // images gardées : au plus CP_IMAGES fois la place des segments
+
+// Coût des changements de contexte, nul par défaut
+typedef struct {
+    int cost;            // commutation : le CPU est occupé sans qu'aucun processus n'avance
+    int warmup;          // réchauffement du cache à la reprise, au plus warmup, sans progrès
+} SwitchCost;
+
+// Surcoût facturé par le modèle de coût
+typedef struct {
+    long long switches;      // commutations vers un processus qui n'était pas chargé sur le CPU
+    long long switch_time;
+    long long warmup_time;
+} Overhead;
+
+/*
+ * Point de reprise : instant où le CPU devient libre, file vide. Tout ce qui
+ * est arrivé est terminé, donc la politique peut repartir d'une file neuve.
+ * En pleine charge, un point est pris à intervalles bornés avec l'image des
+ * processus en cours : file de la politique, E/S, commutations.
+ */
+typedef struct {
+    int next;            // processus déjà arrivés (rang dans order)
+    long long time;
+    long long events;
+    int segments;        // segments produits jusque-là
+    unsigned long long rng;   // état du générateur à cet instant
+    Overhead overhead;
+    int done;            // parmi eux, processus terminés (tous à l'inactivité)
+    unsigned char *image;     // état des autres, NULL à l'inactivité
+    size_t image_len;
+} Checkpoint;
+
+/*
+ * Image d'une exécution en pleine charge : la même suite d'appels la mesure,
+ * l'écrit puis la relit. Les données par processus ne portent que sur ceux
+ * qui sont arrivés sans avoir terminé (live).
+ */
+enum { SNAP_SIZE, SNAP_SAVE, SNAP_LOAD };
+
+typedef struct {
+    int mode;
+    unsigned char *data;
+    size_t len;          // octets mesurés, écrits ou relus
+    const int *live;     // NULL pendant la mesure
+    int nlive;
+} Snapshot;
+
+// Une politique = quelques fonctions de décision branchées sur le moteur
+typedef struct {
+    int preemptive;                                    // une arrivée coupe la tranche en cours
+    void *(*create)(Engine *e, int quantum);           // nouvelle file vide (une par CPU en SMP)
+    void (*enqueue)(Engine *e, int i);                 // i vient d'arriver
+    int  (*pick_next)(Engine *e);                      // retire et renvoie le prochain, -1 si vide
+    long long (*slice)(Engine *e, int i);              // durée max avant la prochaine décision
+    void (*put_prev)(Engine *e, int i, long long ran); // i a tourné ran unités (peut être NULL)
+    int  (*steal)(Engine *e);                          // retire un processus à migrer (NULL : pick_next)
+    void (*reset)(Engine *e, int i);                   // la case i reçoit un nouveau processus (flux, peut être NULL)
+    void (*snapshot)(Engine *e, Snapshot *s);          // image de la file (NULL : reprise à l'inactivité seulement)
+} SchedClass;
+
+// Machine simulée : ncpu = 1 garde le moteur mono-CPU
+typedef struct {
+    int ncpu;
+    int global_queue;    // une seule file partagée au lieu d'une file par CPU
+    int steal;           // un CPU inactif vole dans la file la plus chargée
+} SmpConfig;
+
+// Résultats propres au SMP (ncpu > 1)
+typedef struct {
+    Schedule *cpu_sched;     // segments de chaque CPU
+    long long *busy;         // temps occupé de chaque CPU
+    long long *migrations;   // arrivées de processus venant d'un autre CPU, par CPU
+    long long total_migrations;
+    long long steals;
+} SmpStats;
+
+// Périphérique d'E/S : serveur FIFO, un processus servi à la fois
+typedef struct {
+    int current;         // processus servi, -1 si libre
+    int head, tail;      // file d'attente chaînée par IoState.next, -1 si vide
+} IoDevice;
+
+// État des E/S, alloué seulement si la trace en contient
+typedef struct {
+    IoDevice *dev;
+    int ndev;
+    int *phase;          // E/S commencées par chaque processus
+    int *next;           // suivant dans la file d'un périphérique
+    long long *blocked;  // temps passé bloqué, attente du périphérique comprise
+    long long *since;    // début du blocage en cours
+    long long *ready;    // fin de la dernière E/S tant qu'il n'a pas repris le CPU, -1 sinon
+    long long *response; // somme des délais entre fin d'E/S et reprise du CPU
+    MinHeap wake;        // périphériques en service, par date de fin d'E/S
+} IoState;
+
+// État du modèle de coût, alloué seulement si un coût est non nul
+typedef struct {
+    int *last;           // dernier processus chargé sur chaque CPU, -1 au départ
+    long long *clock;    // temps d'exécution cumulé de chaque CPU
+    int *cpu;            // dernier CPU de chaque processus, -1 sinon
+    long long *mark;     // horloge de ce CPU quand le processus l'a quitté
+    long long *warm;     // réchauffement restant avant que le processus avance
+} SwitchState;
+
+struct Engine {
+    Process *p;
+    int n;
+    const int *order;    // indices triés par (arrival, index), souvent partagés par la table
+    long long *start;    // premier passage sur le CPU, -1 sinon
+    long long *finish;   // date de fin
+    long long time;
+    long long horizon;   // date de fin du dernier processus (politiques conservatives)
+    long long events;
+    int level;           // niveau de la tranche choisie (multilevel)
+    int aging;           // incrément de priorité par unité vieillie (multilevel), niveaux gagnés par lot (MLFQ)
+    int levels;          // nombre de niveaux (MLFQ)
+    unsigned long long rng;   // état du générateur pseudo-aléatoire, DEFAULT_SEED au départ
+    IoState *io;         // NULL si aucun processus ne fait d'E/S
+    SwitchCost cost;
+    Overhead overhead;
+    SwitchState *sw;     // NULL si les changements de contexte sont gratuits
+    Stream *stream;      // arrivées lues au fil de l'eau, NULL si la table est complète
+    long long *seq;      // rang d'admission de chaque case (flux), NULL : l'indice suffit
+    long long admitted;
+    const SchedClass *cls;
+    int first;           // rang dans order du premier processus à livrer (reprise)
+    int done;            // processus déjà terminés (reprise)
+    const unsigned char *image;   // état à recharger par engine_run (reprise en pleine charge), NULL sinon
+    int checkpointing;   // enregistre des points de reprise
+    Checkpoint *cp;
+    int nb_cp, cp_cap;
+    void *rq;            // file d'attente privée de la politique
+    void *policy_data;   // état de la politique commun à toutes ses files
+    SmpConfig smp;
+    SmpStats stats;
+    Schedule sched;      // segments produits par engine_run (tous CPU, par date)
+    Arena *arena;        // mémoire de l'exécution, libérée par engine_free
+    ArenaMark mark;
+#ifdef PROFILE
+    ProfCounters prof;
+#endif
+};
+
+// order : ordre d'arrivée déjà calculé (table_order), ou NULL pour le calculer
+int  engine_init(Engine *e, Process p[], int n, const int *order, Arena *a);
+// Mode flux : p[] devient un ensemble de n cases, remplies par s à chaque arrivée
+int  engine_stream(Engine *e, Stream *s);
+int  engine_run(Engine *e, const SchedClass *cls, void *rq);
+int  smp_run(Engine *e, const SchedClass *cls, int quantum);
+// Crée la ou les files de la politique et lance le moteur adapté à e->smp
+int  engine_simulate(Engine *e, const SchedClass *cls, int quantum);
+void *heap_create(Engine *e, int quantum);   // tas vide de capacité n (politiques à clé)
+// Reprend au dernier point de prev encore valable pour la nouvelle trace de e
+int  engine_resume(Engine *e, const Engine *prev);
+void heap_snapshot(Engine *e, Snapshot *s);  // image d'une file heap_create
+
+void snap_bytes(Snapshot *s, void *p, size_t n);
+#define SNAP(s, x) snap_bytes((s), &(x), sizeof(x))
+// Champ de taille size, tous les stride octets à partir de array, pour chaque processus en cours
+void snap_live(Snapshot *s, void *array, size_t stride, size_t size);
+#define SNAP_LIVE(s, a) snap_live((s), (a), sizeof(*(a)), sizeof(*(a)))
+void snap_heap(Snapshot *s, MinHeap *h);
+// File circulaire : ses éléments dans l'ordre, relus à partir de la case 0
+void snap_ring(Snapshot *s, int *queue, int size, int *head, int *count);
+size_t engine_image_size(Engine *e, int nlive);
+// Point en pleine charge : next processus arrivés, dont done terminés, tous avant oldest.
+// Remplit l'image de c, de taille c->image_len ; 0 faute de mémoire
+int  engine_snapshot(Engine *e, int oldest, int next, int done, Checkpoint *c);
+void engine_restore(Engine *e);
+void engine_free(Engine *e);
+
+// Prochain processus prêt au plus tard à now : arrivée (rang next), puis fin d'E/S ; -1 sinon
+int  engine_next_ready(Engine *e, int *next, long long now);
+// Date de la prochaine arrivée ou fin d'E/S, LLONG_MAX s'il n'y en a plus
+long long engine_next_event(const Engine *e, int next);
+
+int  io_init(Engine *e);
+// i a fini sa rafale CPU à now : 1 s'il part en E/S, 0 s'il a terminé
+int  io_block(Engine *e, int i, long long now);
+// Termine la prochaine E/S et renvoie le processus réveillé, sa rafale suivante en remaining
+int  io_wake(Engine *e);
+void io_reset(Engine *e, int i);
+
+int  switch_init(Engine *e);
+// i prend le CPU c : renvoie le temps de commutation et fixe son réchauffement
+long long switch_in(Engine *e, int c, int i);
+// i quitte le CPU c après ran unités : renvoie la part qui a fait avancer son travail
+long long switch_out(Engine *e, int c, int i, long long ran);
+void switch_reset(Engine *e, int i);
+
+// Mode flux : date de la prochaine arrivée (LLONG_MAX à la fin), puis sa case (-1 : aucune libre)
+long long stream_peek(Stream *s);
+int  stream_admit(Stream *s);
+void stream_ran(Engine *e, int i, long long start, long long end);
+// i a terminé : sa ligne est écrite, puis sa case rendue une fois la politique prévenue
+void stream_retire(Engine *e, int i);
+void stream_release(Engine *e, int i);
+
+// Réchauffement à ajouter à la tranche de i
+static inline long long switch_warmup(const Engine *e, int i) {
+    return e->sw ? e->sw->warm[i] : 0;
+}
+
+static inline long long io_next_wake(const Engine *e) {
+    return e->io && !heap_empty(&e->io->wake) ? e->io->wake.key[heap_top(&e->io->wake)] : LLONG_MAX;
+}
+
+// i a encore une E/S à faire après sa rafale en cours
+static inline int io_pending(const Engine *e, int i) {
+    return e->io && e->io->phase[i] < e->p[i].nio;
+}
+
+static inline long long engine_blocked(const Engine *e, int i) {
+    return e->io ? e->io->blocked[i] : 0;
+}
+
+// i prend le CPU à now : premier passage, ou première reprise après une E/S
+static inline void engine_dispatch(Engine *e, int i, long long now) {
+    if(e->start[i] < 0) e->start[i] = now;
+    if(e->io && e->io->ready[i] >= 0) {
+        e->io->response[i] += now - e->io->ready[i];
+        e->io->ready[i] = -1;
+    }
+}
+
+#endif
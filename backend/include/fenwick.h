@@ -0,0 +1,23 @@
+#ifndef FENWICK_H
+#define FENWICK_H
+#include "arena.h"
+
+/*
+ * Arbre de Fenwick indexé par numéro de processus : sommes préfixes des
+ * poids en O(log n), et recherche du processus qui couvre une position
+ * donnée dans la somme (tirage de loterie) en une seule descente.
+ */
+typedef struct {
+    long long *tree;     // tree[k] (base 1) : somme des poids de ]k - lowbit(k), k]
+    int n;
+    int top;             // plus grande puissance de 2 <= n
+    long long total;
+} Fenwick;
+
+int  fenwick_init(Fenwick *f, int n, Arena *a);
+void fenwick_add(Fenwick *f, int i, long long delta);
+long long fenwick_weight(const Fenwick *f, int i);
+// Plus petit i tel que poids[0] + ... + poids[i] > r, pour 0 <= r < total
+int  fenwick_find(const Fenwick *f, long long r);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HEAP_H
+#define HEAP_H
+#include "arena.h"
+
+// Tas binaire min indexé par numéro de processus (clé, puis rang)
+typedef struct {
+    int *heap;        // indices de processus
+    int *pos;         // position dans heap, -1 si absent
+    long long *key;
+    const long long *rank;   // ordre des clés égales, NULL : l'indice
+    int size;
+    int cap;
+} MinHeap;
+
+int  heap_init(MinHeap *h, int cap, Arena *a);
+void heap_push(MinHeap *h, int i, long long key);   // insère ou met à jour la clé
+void heap_update(MinHeap *h, int i, long long key); // decrease/increase-key
+int  heap_pop(MinHeap *h);                          // -1 si vide
+void heap_remove(MinHeap *h, int i);
+
+static inline int heap_empty(const MinHeap *h) { return h->size == 0; }
+static inline int heap_top(const MinHeap *h) { return h->size ? h->heap[0] : -1; }
+static inline int heap_contains(const MinHeap *h, int i) { return h->pos[i] >= 0; }
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef METRICS_H
+#define METRICS_H
+#include "engine.h"
+
+// Indicateurs agrégés d'une exécution terminée
+typedef struct {
+    double avg_waiting;
+    double avg_turnaround;
+    double avg_response;     // par rafale CPU : arrivée ou fin d'E/S jusqu'au passage suivant sur le CPU
+    double avg_blocked;      // temps moyen passé en E/S, attente du périphérique comprise
+    double throughput;       // processus terminés par unité de temps
+    double cpu_utilization;  // part du temps où le CPU est occupé
+    long long makespan;
+    int switches;            // changements de processus, sommés sur les CPU
+    long long overhead;      // temps de commutation et de réchauffement du cache
+    int ncpu;
+    long long migrations;    // reprises d'un processus sur un autre CPU
+    double fairness;         // indice de Jain du retard par rapport au partage pondéré idéal (1 = équitable)
+    double max_slowdown;     // pire rapport séjour / burst
+    double share_error;      // plus grand écart, en unités de temps, entre service reçu et partage pondéré idéal
+} Metrics;
+
+// Sans l'équité : fairness vaut 1 et share_error 0 tant qu'engine_fairness n'est pas appelée
+void engine_metrics(const Engine *e, Metrics *m);
+// Comparaison au partage pondéré idéal (GPS), en O(n log n) : seulement si elle est affichée
+void engine_fairness(const Engine *e, Metrics *m);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef NICE_H
+#define NICE_H
+
+// Poids d'un nice à 0 : une unité de temps réel = une unité de temps virtuel
+#define NICE_0_WEIGHT 1024
+
+/*
+ * Poids CFS d'un processus. La priorité se lit comme un nice (plus petit =
+ * plus prioritaire), ramenée dans [-20, 19] ; chaque cran vaut environ 1,25x.
+ */
+int nice_weight(int priority);
+
+#endif
@@ -1,15 +1,58 @@
 #ifndef PROCESS_H
 #define PROCESS_H
+#include "arena.h"
+#include "strpool.h"
+
+#define MAX_DEVICES 256   // périphériques d'E/S numérotés de 0 à MAX_DEVICES - 1
+
+// Une E/S sur un périphérique, puis la rafale CPU qui la suit
+typedef struct {
+    int device;
+    int length;
+    int cpu;
+} IoBurst;
 
 typedef struct {
     int id;
-    char name[20];
+    int nio;             // nombre d'E/S, 0 pour un processus purement calcul
+    const char *name;    // interné dans le pool de la table
     int arrival;
-    int burst;
+    int burst;           // temps CPU total, toutes rafales comprises
     int priority;
-    int remaining;
+    int remaining;       // reste de la rafale CPU en cours
+    const IoBurst *io;   // nio E/S, dans l'arène de la table (NULL si nio = 0)
 } Process;
 
-int lire_fichier_processus(char *filename, Process p[], int *n);
+// Première rafale CPU : le total moins les rafales qui suivent les E/S
+int process_first_burst(const Process *p);
+
+// Indices triés par (arrivée, indice) dans order ; mémoire de travail prise dans a
+int sort_by_arrival(const Process p[], int n, int order[], Arena *a);
+
+// Mémoire de travail réservée par processus pour une exécution (moteur, files)
+#define RUN_BYTES_PER_PROCESS 64
+
+// Table de processus extensible, allouée dans l'arène de l'exécution
+typedef struct {
+    Process *p;
+    int n;
+    int cap;
+    Arena arena;
+    StringPool names;
+    int *order;          // ordre d'arrivée partagé par les exécutions, NULL tant qu'il n'est pas calculé
+    void *map;           // trace binaire projetée (noms), NULL sinon
+    size_t map_len;
+#ifdef PROFILE
+    double load_time;    // lecture du fichier, en secondes (0 hors lire_fichier_processus)
+#endif
+} ProcessTable;
+
+int  table_init(ProcessTable *t, int cap);
+Process *table_push(ProcessTable *t);
+// Calculé au premier appel, avant de partager la table entre threads ; NULL si mémoire insuffisante
+const int *table_order(ProcessTable *t);
+void table_free(ProcessTable *t);
+
+int lire_fichier_processus(char *filename, ProcessTable *t);
 
-#endif
\ No newline at end of file
+#endif
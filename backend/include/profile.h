@@ -0,0 +1,35 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+#include <stdio.h>
+
+/*
+ * Profilage intégré, compilé seulement avec -DPROFILE (make PROFILE=1) :
+ * sans lui, les macros ne produisent aucun code et les structures n'ont pas
+ * les champs. Chaque politique rendue écrit alors une ligne JSON sur stderr.
+ */
+typedef struct {
+    long long decisions;     // processus choisis pour un CPU
+    long long queue_ops;     // appels enqueue, pick_next, put_prev et steal
+    long long preemptions;   // tranches coupées par une arrivée ou un réveil
+    long long idle_skips;    // périodes d'inactivité sautées d'un coup
+    long long idle_time;     // leur durée simulée
+} ProfCounters;
+
+typedef struct {
+    double load, simulate, render;   // secondes, horloge murale
+    long long output_bytes;
+} ProfPhases;
+
+#ifdef PROFILE
+#define PROF_COUNT(e, field) ((e)->prof.field++)
+#define PROF_ADD(e, field, v) ((e)->prof.field += (v))
+#else
+#define PROF_COUNT(e, field) ((void)0)
+#define PROF_ADD(e, field, v) ((void)0)
+#endif
+
+double prof_now(void);   // secondes, horloge monotone
+void   prof_report(FILE *out, const char *policy, int quantum, int ncpu, long long events,
+                   const ProfCounters *c, const ProfPhases *ph);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+#include "arena.h"
+
+#define RB_ABSENT (-2)   // parent d'un processus hors de l'arbre
+
+// Arbre rouge-noir indexé par numéro de processus (clé, puis rang)
+typedef struct {
+    int *left, *right, *parent;   // -1 : pas de fils / racine
+    unsigned char *red;
+    long long *key;
+    const long long *rank;        // ordre des clés égales, NULL : l'indice
+    int root;
+    int leftmost;                 // plus petite clé, gardée à jour : -1 si vide
+    int size;
+} RbTree;
+
+int  rb_init(RbTree *t, int cap, Arena *a);
+void rb_insert(RbTree *t, int i, long long key);   // i ne doit pas être dans l'arbre
+void rb_remove(RbTree *t, int i);
+
+static inline int rb_empty(const RbTree *t) { return t->size == 0; }
+static inline int rb_first(const RbTree *t) { return t->leftmost; }
+static inline int rb_contains(const RbTree *t, int i) { return t->parent[i] != RB_ABSENT; }
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef RENDER_H
+#define RENDER_H
+#include <stdio.h>
+#include "scheduler.h"
+#include "writer.h"
+
+// Sortie texte (Gantt coloré) construite à partir des segments
+void render_text(FILE *out, const Policy *pol, const Engine *e, int quantum);
+
+// Objet JSON : segments, métriques par processus et moyennes
+void render_json(FILE *out, const Policy *pol, const Engine *e, int quantum);
+void json_print_string(FILE *out, const char *s);
+void w_json_string(Writer *w, const char *s);
+
+// Mode métriques : indicateurs agrégés seulement, sans Gantt ni segments
+void render_metrics_header(FILE *out);
+void render_metrics_text(FILE *out, const Policy *pol, const Engine *e, int quantum);
+void render_metrics_json(FILE *out, const Policy *pol, const Engine *e, int quantum);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+#include <stddef.h>
+#include "process.h"
+#include "engine.h"
+
+#define CACHE_SLOTS      256
+#define CACHE_MAX_BYTES  (128u << 20)
+// Version du JSON rendu et du comportement du moteur : à incrémenter dès
+// qu'une même exécution peut rendre autre chose, les anciennes entrées ne
+// sont alors plus jamais lues
+#define CACHE_VERSION    2
+
+// Empreinte 128 bits de la liste de processus normalisée (champs lus, pas le texte)
+typedef struct {
+    unsigned long long h[2];
+} WorkloadKey;
+
+void workload_key(const ProcessTable *t, WorkloadKey *k);
+
+// Tout ce qui, avec la trace, détermine la sortie rendue
+typedef struct {
+    int policy, quantum, aging, levels;
+    unsigned long long seed;
+    SmpConfig smp;
+    SwitchCost cost;
+} CacheParams;
+
+// Clé d'une exécution : trace, paramètres et CACHE_VERSION
+void cache_key(const WorkloadKey *trace, const CacheParams *p, WorkloadKey *k);
+
+typedef struct {
+    WorkloadKey key;
+    char *output;          // objet JSON rendu de l'exécution
+    size_t len;
+} CacheEntry;
+
+/*
+ * Cache des résultats rendus, adressé par contenu : la clé réunit trace,
+ * paramètres de l'exécution et version. En mémoire, les entrées les plus anciennes sortent en
+ * premier ; avec un répertoire, chaque résultat est aussi un fichier partagé
+ * entre les processus serveurs.
+ */
+typedef struct {
+    CacheEntry slots[CACHE_SLOTS];
+    int oldest, used;
+    size_t bytes;
+    const char *dir;       // NULL : mémoire seulement
+} ResultCache;
+
+void cache_init(ResultCache *c, const char *dir);
+void cache_free(ResultCache *c);
+
+// Renvoie une copie (malloc) de la sortie, ou NULL
+char *cache_get(ResultCache *c, const WorkloadKey *k, size_t *len);
+void  cache_put(ResultCache *c, const WorkloadKey *k, const char *output, size_t len);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef RNG_H
+#define RNG_H
+
+// splitmix64 : rapide, et la même graine donne la même suite partout
+static inline unsigned long long rng_next(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Tirage dans [0, bound) par multiplication, sans division
+static inline unsigned long long rng_below(unsigned long long *state, unsigned long long bound) {
+    return (unsigned long long)(((unsigned __int128)rng_next(state) * bound) >> 64);
+}
+
+#endif
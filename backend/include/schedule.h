@@ -0,0 +1,29 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+#include "arena.h"
+
+// Tranche d'exécution contiguë d'un processus sur le CPU
+typedef struct {
+    int proc;
+    long long start;
+    long long end;
+    int level;
+    int cpu;
+} Segment;
+
+// Ordonnancement = suite de segments triés par date de début
+typedef struct {
+    Segment *seg;
+    int count;
+    int cap;
+    int cpu;             // CPU des segments ajoutés par schedule_add
+    Arena *arena;
+} Schedule;
+
+int schedule_init(Schedule *s, Arena *a, int cap);
+int schedule_add(Schedule *s, int proc, long long start, long long end, int level);
+int schedule_switches(const Schedule *s);   // passages d'un processus à un autre
+// Réunit les segments de plusieurs CPU dans dst, par date de début puis CPU
+int schedule_merge(Schedule *dst, const Schedule src[], int count);
+
+#endif
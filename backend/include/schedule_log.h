@@ -0,0 +1,99 @@
+#ifndef SCHEDULE_LOG_H
+#define SCHEDULE_LOG_H
+#include <stdint.h>
+#include "engine.h"
+
+/*
+ * Journal binaire d'ordonnancement (petit-boutiste), projetable en mémoire :
+ *   SchedLogHeader | événements | SchedLogIndex[] | SchedLogProc[nproc] | noms
+ * Les événements (segments, arrivées, fins) sont rangés par date. Chacun
+ * s'écrit en entiers variables : écart de date avec le précédent et type,
+ * écart de processus, puis pour un segment CPU, durée et niveau. Tous les
+ * SCHED_LOG_BLOCK événements, ces écarts repartent de zéro et une entrée
+ * d'index donne la date et la position du bloc : on lit une fenêtre de
+ * temps sans décoder ce qui précède.
+ */
+#define SCHED_LOG_MAGIC   "OSSCHED"
+#define SCHED_LOG_VERSION 1
+#define SCHED_LOG_BLOCK   1024
+
+enum { LOG_SEGMENT, LOG_ARRIVAL, LOG_FINISH };
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t block;          // événements par entrée d'index
+    uint32_t ncpu;
+    int32_t policy;
+    int32_t quantum;
+    uint32_t reserved;
+    uint64_t nproc;
+    uint64_t nevents;
+    uint64_t nsegments;
+    int64_t makespan;
+    uint64_t events_offset, events_size;
+    uint64_t index_offset;   // (nevents + block - 1) / block entrées
+    uint64_t procs_offset;
+    uint64_t names_offset, names_size;
+} SchedLogHeader;
+
+typedef struct {
+    int64_t time;            // date du premier événement du bloc
+    uint64_t offset;         // position dans la zone des événements
+    uint64_t live_from;      // premier bloc où commence un segment encore en cours à cette date
+} SchedLogIndex;
+
+typedef struct {
+    int32_t id;
+    int32_t arrival;
+    int32_t burst;
+    int32_t priority;
+    int64_t start;           // premier passage sur un CPU, -1 sinon
+    int64_t finish;
+    uint64_t name;           // décalage dans la zone des noms
+} SchedLogProc;
+
+// Écrit l'ordonnancement simulé par e ; 0 si le fichier n'a pas pu être écrit
+int schedule_log_write(const char *filename, const Engine *e, int policy, int quantum);
+
+// Journal projeté en lecture
+typedef struct {
+    void *map;
+    size_t len;
+    const SchedLogHeader *h;
+    const uint8_t *events;
+    const SchedLogIndex *index;
+    uint64_t nindex;
+    const SchedLogProc *proc;
+    const char *names;
+} SchedLog;
+
+typedef struct {
+    int kind;                // LOG_SEGMENT, LOG_ARRIVAL ou LOG_FINISH
+    long long time;          // début du segment, arrivée ou fin
+    int proc;                // rang dans la table du journal
+    int cpu;                 // segment seulement
+    long long end;
+    int level;
+} LogEvent;
+
+typedef struct {
+    const SchedLog *log;
+    const uint8_t *pos;
+    uint64_t event;          // numéro du prochain événement
+    long long time;
+    int proc;
+} LogCursor;
+
+int  schedule_log_open(SchedLog *l, const char *filename);   // 0 si illisible ou incohérent
+void schedule_log_close(SchedLog *l);
+// Premier bloc à décoder pour voir les segments en cours à la date t et tous les événements qui suivent
+uint64_t log_block_from(const SchedLog *l, long long t);
+void log_seek(LogCursor *c, const SchedLog *l, uint64_t block);
+int  log_next(LogCursor *c, LogEvent *ev);   // 1 si un événement, 0 à la fin, -1 si corrompu
+
+static inline const char *log_name(const SchedLog *l, int i) {
+    return l->names + l->proc[i].name;
+}
+
+#endif
@@ -1,8 +1,82 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
+#include <stdio.h>
 #include "process.h"
+#include "engine.h"
 
-void run_scheduler(int policy, Process p[], int n, int quantum);
+// Options d'affichage texte d'une politique
+#define SHOW_PRIORITY    1   // colonne priorité dans le tableau des processus
+#define ROW_PER_SEGMENT  2   // une ligne de Gantt par tranche, dans l'ordre d'exécution
+#define SWITCH_LOG       4   // journal des changements de processus
+#define LEVEL_TIMELINE   8   // chronologie par niveau (multilevel)
+#define FAIRNESS        16   // bilan d'équité après le résumé
 
+typedef struct {
+    int id;
+    const char *name;        // nom court : "FIFO", "SRTF"...
+    const char *title;       // bannière de la sortie texte
+    int uses_quantum;
+    int uses_aging;          // sensible à l'incrément de vieillissement
+    int flags;
+    int (*simulate)(Engine *e, int quantum);
+} Policy;
 
-#endif
\ No newline at end of file
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_JSON,
+    FORMAT_METRICS,        // une ligne d'indicateurs par politique, sans Gantt
+    FORMAT_METRICS_JSON    // objet JSON sans segments ni détail par processus
+} OutputFormat;
+
+static inline int format_is_json(OutputFormat f) {
+    return f == FORMAT_JSON || f == FORMAT_METRICS_JSON;
+}
+
+// Une exécution d'une politique sur une table de processus
+typedef struct SchedRun {
+    const Policy *pol;
+    int policy;
+    int quantum;
+    int aging;         // incrément de vieillissement (multilevel), 1 par défaut
+    int levels;        // niveaux de la MLFQ, DEFAULT_LEVELS par défaut
+    unsigned long long seed;   // graine du générateur (loterie), DEFAULT_SEED par défaut
+    SmpConfig smp;     // 1 CPU par défaut
+    SwitchCost cost;   // changements de contexte gratuits par défaut
+    int prepared;
+    int ok;
+    Engine e;
+    Process *p;        // table partagée, ou copie privée en mode parallèle
+    int n;
+    const int *order;  // ordre d'arrivée de la table, commun à toutes ses exécutions
+    Arena *arena;
+    Arena own;         // arène privée (copie des processus) en mode parallèle
+    int private_copy;
+    int checkpointing; // garde des points de reprise pour une exécution suivante
+    const struct SchedRun *resume_from;   // exécution précédente à prolonger, ou NULL
+    OutputFormat format;
+    char *output;      // sortie déjà rendue par le thread de simulation, ou NULL
+    size_t output_len;
+#ifdef PROFILE
+    ProfPhases prof;
+#endif
+} SchedRun;
+
+const Policy *find_policy(int id);
+const Policy *policy_list(int *count);
+void run_scheduler(int policy, ProcessTable *t, int quantum, OutputFormat format);
+
+int  sched_run_prepare(SchedRun *r, int policy, ProcessTable *t, int quantum, int private_copy);
+void sched_run_simulate(SchedRun *r);
+void sched_run_render(SchedRun *r, OutputFormat format, FILE *out);
+void sched_run_release(SchedRun *r);
+
+// Rend dans r->output au lieu d'un FILE ; sched_run_render le recopiera
+int  sched_run_render_buffer(SchedRun *r, OutputFormat format);
+// Exécution dont seule la sortie rendue est connue (cache) : rien à simuler
+void sched_run_from_output(SchedRun *r, int policy, char *output, size_t len);
+
+// Simule et rend en mémoire toutes les exécutions préparées avec copie privée,
+// un thread chacune ; sched_run_render recopie ensuite la sortie dans l'ordre
+void simulate_parallel(SchedRun runs[], int count, OutputFormat format);
+
+#endif
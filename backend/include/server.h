@@ -0,0 +1,18 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+/*
+ * Mode serveur : requêtes encadrées sur l'entrée standard, une réponse JSON
+ * par ligne sur la sortie standard.
+ *
+ *   SIMULATE <id> <nb_processus> <quantum> <choix,choix,...>
+ *   <nom arrivée burst priorité>   (nb_processus lignes)
+ *
+ * Réponse : {"id":"<id>","results":[...]} ou {"id":"<id>","error":"..."}
+ *
+ * Les résultats sont mis en cache par (trace, politique, quantum), en
+ * mémoire et, si cache_dir n'est pas NULL, dans ce répertoire.
+ */
+int run_server(int parallel, const char *cache_dir);   // parallel : une politique par thread
+
+#endif
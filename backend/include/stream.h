@@ -0,0 +1,58 @@
+#ifndef STREAM_H
+#define STREAM_H
+#include "process.h"
+#include "engine.h"
+#include "scheduler.h"
+#include "trace_reader.h"
+#include "writer.h"
+
+#define DEFAULT_MAX_ACTIVE 65536   // cases du mode flux : processus présents en même temps
+
+// Totaux des processus terminés, seuls gardés une fois leur ligne écrite
+typedef struct {
+    long long count;
+    double sum_waiting, sum_turnaround, sum_response, sum_blocked;
+    long long bursts;        // rafales CPU, pour le temps de réponse moyen
+    long long busy;          // temps CPU occupé
+    long long switches;
+    int last;                // dernier processus passé sur le CPU, -1 au départ, -2 s'il a terminé
+    double max_slowdown;
+    int active, peak;        // cases occupées, et leur maximum
+} StreamTotals;
+
+/*
+ * Flux d'arrivées : les processus sont lus un par un, dans l'ordre des
+ * arrivées, quand la simulation atteint la date du prochain. Chacun prend
+ * une case libre du moteur et la rend en terminant, après l'écriture de sa
+ * ligne : la mémoire dépend du nombre de processus présents, pas de la
+ * longueur de la trace.
+ */
+struct Stream {
+    TraceReader reader;
+    Arena scratch;           // analyse de la ligne en avance, effacée à chaque ligne
+    ArenaMark mark;
+    StringPool names;
+    Process ahead;           // prochaine arrivée, déjà lue
+    int has_ahead;
+    int last_arrival;
+    int ids;                 // processus lus
+    int ended;               // fin de la trace, ou lecture arrêtée
+    int failed;              // arrêtée faute de case libre
+    int cap;
+    Process *p;              // cases, données au moteur comme table de processus
+    char **name;             // nom de chaque case, agrandi au besoin
+    size_t *name_cap;
+    IoBurst **io;            // E/S de chaque case, idem
+    int *io_cap;
+    int *free_slots;         // pile des cases libres
+    int nfree;
+    OutputFormat format;
+    Writer *out;
+    StreamTotals totals;
+};
+
+// Simule la politique sur la trace lue au fil de l'eau ("-" : entrée standard)
+int run_stream(const char *filename, int policy, int quantum, int max_active, int levels, unsigned long long seed,
+               SwitchCost cost, OutputFormat format);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef STRPOOL_H
+#define STRPOOL_H
+#include <stddef.h>
+#include "arena.h"
+
+// Noms internés : une seule copie par nom distinct, dans l'arène
+typedef struct {
+    int *slots;             // table de hachage -> identifiant, -1 si vide
+    unsigned *hashes;
+    int cap;
+    const char **strings;   // identifiant -> nom
+    int count;
+    int strings_cap;
+    Arena *arena;
+} StringPool;
+
+int pool_init(StringPool *sp, Arena *a, int cap);
+int pool_id(StringPool *sp, const char *s, size_t len);   // -1 si mémoire insuffisante
+const char *pool_intern(StringPool *sp, const char *s, size_t len);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+#include "process.h"
+#include "scheduler.h"
+
+// Plage d'entiers first..last par pas de step : "4", "1:8" ou "1:20:2"
+typedef struct {
+    int first, last, step;
+} Range;
+
+int parse_range(const char *text, Range *r);
+
+/*
+ * Balayage : chaque politique à quantum est simulée pour chaque quantum de
+ * la plage (et chaque incrément d'aging si elle y est sensible), sur un
+ * pool de threads. Affiche une ligne d'indicateurs par configuration.
+ */
+int run_sweep(ProcessTable *t, Range quanta, Range aging, int levels, unsigned long long seed, SmpConfig smp,
+              SwitchCost cost, OutputFormat format);
+
+#endif
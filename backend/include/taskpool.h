@@ -0,0 +1,17 @@
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+// Une tâche est un indice dans [0, count) passé à fn avec le contexte partagé
+typedef void (*TaskFn)(void *ctx, int task);
+
+/*
+ * Exécute count tâches indépendantes sur nthreads threads. Chaque thread
+ * reçoit un bloc contigu de tâches dans sa propre file et, une fois vide,
+ * vole par l'autre bout dans la file d'un voisin. Le thread appelant
+ * participe. Renvoie 0 si la mémoire manque (rien n'a été exécuté).
+ */
+int taskpool_run(int count, int nthreads, TaskFn fn, void *ctx);
+
+int taskpool_default_threads(void);   // nombre de CPU en ligne, au moins 1
+
+#endif
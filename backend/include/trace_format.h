@@ -0,0 +1,42 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+#include <stdint.h>
+#include "process.h"
+
+/*
+ * Trace binaire (petit-boutiste), projetable en mémoire :
+ *   TraceHeader | TraceRecord[count] | TraceIo[io_count] | noms terminés par '\0'
+ * Version 2 : ajout des E/S ; une trace de version 1 se reconvertit depuis le texte.
+ */
+#define TRACE_MAGIC   "OSTRACE"
+#define TRACE_VERSION 2
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t names_offset;
+    uint64_t names_size;
+    uint64_t io_count;
+} TraceHeader;
+
+typedef struct {
+    int32_t arrival;
+    int32_t burst;        // temps CPU total
+    int32_t priority;
+    uint32_t name;        // décalage dans la zone des noms
+    uint32_t io;          // première E/S dans la zone des E/S
+    uint32_t nio;
+} TraceRecord;
+
+typedef struct {
+    int32_t device;
+    int32_t length;
+    int32_t cpu;          // rafale CPU qui suit l'E/S
+} TraceIo;
+
+int trace_is_binary(const char *filename);
+int charger_trace_binaire(const char *filename, ProcessTable *t);
+
+#endif
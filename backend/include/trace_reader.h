@@ -0,0 +1,25 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+#include <stdio.h>
+#include "process.h"
+#include "strpool.h"
+
+// Lecteur de trace texte bufferisé : "nom arrivée burst priorité" par ligne
+typedef struct {
+    FILE *f;
+    const char *filename;
+    char *buf;
+    size_t cap, len, pos;
+    int line;
+    int errors;
+    int eof;
+} TraceReader;
+
+int  trace_open(TraceReader *r, const char *filename);   // "-" = entrée standard
+int  trace_next(TraceReader *r, StringPool *names, Process *out); // 1 = processus lu, 0 = fin
+int  trace_read_line(TraceReader *r, const char **line, const char **end);
+// 1 = processus lu, 0 = ligne vide ou commentaire, -1 = ligne invalide (signalée)
+int  trace_parse_process(TraceReader *r, const char *line, const char *end, StringPool *names, Process *out);
+void trace_close(TraceReader *r);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef VECSCAN_H
+#define VECSCAN_H
+
+/*
+ * Recherches linéaires sur un tableau d'entiers contigu : une réduction
+ * vectorielle donne l'extremum, puis une comparaison vectorielle trouve sa
+ * première position. AVX2 si compilé avec -mavx2, SSE2 sinon sur x86-64,
+ * boucle simple ailleurs ; le résultat est le même dans tous les cas.
+ */
+int vec_argmin_int(const int *v, int n);   // premier indice du minimum, -1 si n = 0
+int vec_argmax_int(const int *v, int n);   // premier indice du maximum, -1 si n = 0
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+#include "process.h"
+
+/*
+ * Charges synthétiques reproductibles (même graine = même trace), réglées
+ * pour occuper le CPU à environ 90 % :
+ *   uniform  écarts d'arrivée et bursts uniformes
+ *   poisson  arrivées poissoniennes (écarts exponentiels)
+ *   heavy    arrivées poissoniennes, bursts Pareto (queue lourde)
+ *   bursty   rafales d'arrivées simultanées séparées par des silences
+ *   interactive  courtes rafales CPU entre des E/S sur deux périphériques
+ */
+typedef enum {
+    WL_UNIFORM,
+    WL_POISSON,
+    WL_HEAVY,
+    WL_BURSTY,
+    WL_INTERACTIVE,
+    WL_COUNT
+} WorkloadKind;
+
+const char *workload_name(WorkloadKind kind);
+int workload_kind(const char *name, WorkloadKind *kind);   // 0 si nom inconnu
+
+// Remplit une table neuve avec n processus P1..Pn, arrivées croissantes
+int workload_generate(ProcessTable *t, WorkloadKind kind, int n, unsigned long long seed);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef WRITER_H
+#define WRITER_H
+#include <stdio.h>
+#include <string.h>
+
+#define WRITER_BUF 65536
+
+/*
+ * Sortie tamponnée : les rendus écrivent des millions de petits morceaux
+ * (une cellule de Gantt, un nombre), vidés vers le FILE par blocs de 64 Kio.
+ */
+typedef struct {
+    FILE *out;
+    size_t len;
+    char buf[WRITER_BUF];
+} Writer;
+
+void writer_init(Writer *w, FILE *out);
+void w_flush(Writer *w);
+void w_printf(Writer *w, const char *fmt, ...);
+void w_repeat(Writer *w, const char *s, long long count);      // s écrit count fois
+void w_int(Writer *w, long long v, int width);                 // comme "%*lld", width < 0 : à gauche
+void w_str(Writer *w, const char *s, int width);               // comme "%*s"
+
+static inline void w_write(Writer *w, const char *s, size_t len) {
+    if(w->len + len > WRITER_BUF) {
+        w_flush(w);
+        if(len > WRITER_BUF) {
+            fwrite(s, 1, len, w->out);
+            return;
+        }
+    }
+    memcpy(w->buf + w->len, s, len);
+    w->len += len;
+}
+
+static inline void w_puts(Writer *w, const char *s) {
+    w_write(w, s, strlen(s));
+}
+
+static inline void w_putc(Writer *w, char c) {
+    if(w->len == WRITER_BUF) w_flush(w);
+    w->buf[w->len++] = c;
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include "../include/process.h"
+#include "../include/engine.h"
+#include "../include/rbtree.h"
+#include "../include/nice.h"
+
+/*
+ * CFS : les prêts sont rangés par temps virtuel dans un arbre rouge-noir et
+ * le plus à gauche tourne. Le temps virtuel avance à l'inverse du poids (tiré
+ * de la priorité), la tranche est la part du poids dans la période de
+ * latence. Le quantum joue le rôle de granularité minimale.
+ */
+#define CFS_NR_LATENCY 8     // période = 8 granularités tant qu'il y a au plus 8 prêts
+#define VRUNTIME_SHIFT 10    // temps virtuel en 1/1024 d'unité
+
+// État par processus, commun à toutes les files (SMP)
+typedef struct {
+    long long *vruntime;     // relatif à min_vruntime tant qu'il est hors file (vol, E/S)
+    int *weight;
+    long long *granted;      // dernière tranche accordée
+    long long *used;         // temps passé dans la tranche en cours, coupée par des arrivées
+    unsigned char *placed;   // déjà entré dans une file
+} CfsShared;
+
+typedef struct {
+    RbTree tree;
+    long long load;          // somme des poids dans l'arbre
+    long long min_vruntime;  // ne fait que croître
+    int granularity;
+    int curr;                // processus en cours, -1 sinon
+    int preempted;           // coupé par une arrivée, -1 sinon
+    CfsShared *sh;
+} CfsQueue;
+
+static long long to_virtual(long long t, int weight) {
+    return (t << VRUNTIME_SHIFT) * NICE_0_WEIGHT / weight;
+}
+
+static void cfs_insert(CfsQueue *q, int i) {
+    rb_insert(&q->tree, i, q->sh->vruntime[i]);
+    q->load += q->sh->weight[i];
+}
+
+// Plus petit temps virtuel entre le processus en cours (à son dernier choix) et le plus à gauche
+static void update_min_vruntime(CfsQueue *q) {
+    int l = rb_first(&q->tree), c = q->curr;
+    if(c >= 0 && (l < 0 || q->sh->vruntime[c] < q->sh->vruntime[l])) l = c;
+    if(l >= 0 && q->sh->vruntime[l] > q->min_vruntime)
+        q->min_vruntime = q->sh->vruntime[l];
+}
+
+// sched_slice : part du poids de i dans la période, i et le processus en cours compris
+static long long sched_slice(const CfsQueue *q, int i) {
+    long long nr = q->tree.size, load = q->load;
+    if(!rb_contains(&q->tree, i)) {
+        nr++;
+        load += q->sh->weight[i];
+    }
+    if(q->curr >= 0 && q->curr != i) {
+        nr++;
+        load += q->sh->weight[q->curr];
+    }
+    long long period = (long long)q->granularity * (nr > CFS_NR_LATENCY ? nr : CFS_NR_LATENCY);
+    long long slice = period * q->sh->weight[i] / load;
+    return slice > 0 ? slice : 1;
+}
+
+/*
+ * Processus volé : son temps virtuel, rendu relatif par cfs_steal, est
+ * recalé sur min_vruntime. Nouveau venu : placé une tranche virtuelle après
+ * min_vruntime (START_DEBIT), pour ne pas passer devant ceux qui attendent.
+ */
+static void cfs_enqueue(Engine *e, int i) {
+    CfsQueue *q = e->rq;
+    CfsShared *sh = q->sh;
+
+    update_min_vruntime(q);
+    if(!sh->placed[i]) {
+        sh->weight[i] = nice_weight(e->p[i].priority);
+        sh->vruntime[i] = to_virtual(sched_slice(q, i), sh->weight[i]);
+        sh->placed[i] = 1;
+    }
+    sh->vruntime[i] += q->min_vruntime;
+    cfs_insert(q, i);
+}
+
+static int cfs_pick_next(Engine *e) {
+    CfsQueue *q = e->rq;
+    const CfsShared *sh = q->sh;
+    int i = rb_first(&q->tree), c = q->preempted;
+
+    if(i < 0) return -1;
+    // Le processus coupé par une arrivée reprend, sauf si le plus à gauche le devance
+    // de plus d'une granularité (check_preempt_wakeup) ou s'il a épuisé sa part à
+    // la charge actuelle (check_preempt_tick)
+    q->preempted = -1;
+    if(c >= 0 && c != i && rb_contains(&q->tree, c)) {
+        if(sh->vruntime[c] - sh->vruntime[i] <= to_virtual(q->granularity, sh->weight[i])
+           && sched_slice(q, c) > sh->used[c])
+            i = c;
+        else
+            sh->used[c] = 0;
+    }
+    rb_remove(&q->tree, i);
+    q->load -= sh->weight[i];
+    q->curr = i;
+    return i;
+}
+
+// Part de i à la charge actuelle, moins ce qu'il en a déjà consommé avant d'être coupé
+static long long cfs_slice(Engine *e, int i) {
+    CfsQueue *q = e->rq;
+    CfsShared *sh = q->sh;
+    long long slice = sched_slice(q, i) - sh->used[i];
+
+    if(slice < 1) slice = 1;
+    if(slice > e->p[i].remaining) slice = e->p[i].remaining;
+    sh->granted[i] = slice;
+    return slice;
+}
+
+static void cfs_put_prev(Engine *e, int i, long long ran) {
+    CfsQueue *q = e->rq;
+    CfsShared *sh = q->sh;
+
+    sh->vruntime[i] += to_virtual(ran, sh->weight[i]);
+    if(q->curr == i) q->curr = -1;
+    if(e->p[i].remaining > 0) {
+        cfs_insert(q, i);
+        if(ran < sh->granted[i]) {
+            sh->used[i] += ran;
+            q->preempted = i;
+        } else {
+            sh->used[i] = 0;
+        }
+    }
+    update_min_vruntime(q);
+    // Bloqué en E/S : il garde son avance ou son retard sur la file au réveil
+    if(e->p[i].remaining == 0) {
+        sh->vruntime[i] -= q->min_vruntime;
+        sh->used[i] = 0;
+    }
+}
+
+// Migration : le temps virtuel est rendu relatif à la file d'origine
+static int cfs_steal(Engine *e) {
+    CfsQueue *q = e->rq;
+    int i = rb_first(&q->tree);
+
+    if(i < 0) return -1;
+    if(q->preempted == i) q->preempted = -1;
+    rb_remove(&q->tree, i);
+    q->load -= q->sh->weight[i];
+    q->sh->vruntime[i] -= q->min_vruntime;
+    q->sh->used[i] = 0;
+    return i;
+}
+
+static void *cfs_create(Engine *e, int quantum) {
+    Arena *a = e->arena;
+    CfsQueue *q = arena_alloc(a, sizeof(CfsQueue));
+    if(!q || !rb_init(&q->tree, e->n, a)) return NULL;
+    q->tree.rank = e->seq;
+
+    if(!e->policy_data) {
+        CfsShared *sh = arena_alloc(a, sizeof(CfsShared));
+        if(!sh) return NULL;
+        sh->vruntime = arena_calloc(a, e->n, sizeof(long long));
+        sh->weight = arena_alloc(a, sizeof(int) * e->n);
+        sh->granted = arena_calloc(a, e->n, sizeof(long long));
+        sh->used = arena_calloc(a, e->n, sizeof(long long));
+        sh->placed = arena_calloc(a, e->n, 1);
+        if(!sh->vruntime || !sh->weight || !sh->granted || !sh->used || !sh->placed) return NULL;
+        e->policy_data = sh;
+    }
+    q->sh = e->policy_data;
+    q->load = 0;
+    q->min_vruntime = 0;
+    q->granularity = quantum;
+    q->curr = q->preempted = -1;
+    return q;
+}
+
+static void cfs_reset(Engine *e, int i) {
+    CfsShared *sh = e->policy_data;
+    sh->placed[i] = 0;
+    sh->used[i] = 0;
+}
+
+/*
+ * Seule l'appartenance à l'arbre est gardée : un nœud a pour clé son temps
+ * virtuel, et l'ordre (clé, rang) ne dépend pas de la forme de l'arbre, qui
+ * est reconstruit au chargement. Le poids se déduit de la priorité.
+ */
+static void cfs_snapshot(Engine *e, Snapshot *s) {
+    CfsQueue *q = e->rq;
+    CfsShared *sh = q->sh;
+
+    SNAP(s, q->load);
+    SNAP(s, q->min_vruntime);
+    SNAP(s, q->curr);
+    SNAP(s, q->preempted);
+    SNAP_LIVE(s, sh->vruntime);
+    SNAP_LIVE(s, sh->granted);
+    SNAP_LIVE(s, sh->used);
+    SNAP_LIVE(s, sh->placed);
+    for(int k = 0; k < s->nlive; k++) {
+        unsigned char queued = s->mode == SNAP_SAVE && rb_contains(&q->tree, s->live[k]);
+        SNAP(s, queued);
+        if(s->mode != SNAP_LOAD) continue;
+        int i = s->live[k];
+        if(sh->placed[i]) sh->weight[i] = nice_weight(e->p[i].priority);
+        if(queued) rb_insert(&q->tree, i, sh->vruntime[i]);
+    }
+}
+
+static const SchedClass cfs_class = { 1, cfs_create, cfs_enqueue, cfs_pick_next, cfs_slice, cfs_put_prev, cfs_steal, cfs_reset, cfs_snapshot };
+
+int cfs(Engine *e, int quantum) {
+    return engine_simulate(e, &cfs_class, quantum);
+}
@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/engine.h"
+#include "../include/heap.h"
+
+int engine_init(Engine *e, Process p[], int n, const int *order, Arena *a) {
+    e->p = p;
+    e->n = n;
+    e->arena = a;
+    e->mark = arena_mark(a);
+    e->start = arena_alloc(a, sizeof(long long) * n);
+    e->finish = arena_alloc(a, sizeof(long long) * n);
+    if(!schedule_init(&e->sched, a, n) || !e->start || !e->finish) {
+        engine_free(e);
+        return 0;
+    }
+    // Sans ordre partagé par la table, le moteur trie lui-même
+    if(!order) {
+        int *own = arena_alloc(a, sizeof(int) * (n > 0 ? n : 1));
+        if(!own || !sort_by_arrival(p, n, own, a)) {
+            engine_free(e);
+            return 0;
+        }
+        order = own;
+    }
+    e->order = order;
+
+    e->horizon = 0;
+    for(int k = 0; k < n; k++) {
+        int i = order[k];
+        e->start[i] = -1;
+        e->finish[i] = -1;
+        p[i].remaining = process_first_burst(&p[i]);
+        if(e->horizon < p[i].arrival) e->horizon = p[i].arrival;
+        e->horizon += p[i].burst;
+    }
+    if(!io_init(e)) {
+        engine_free(e);
+        return 0;
+    }
+
+    e->time = 0;
+    e->events = 0;
+    e->level = 0;
+    e->aging = 1;
+    e->levels = DEFAULT_LEVELS;
+    e->rng = DEFAULT_SEED;
+    e->first = e->done = 0;
+    e->image = NULL;
+    e->checkpointing = 0;
+    e->cp = NULL;
+    e->nb_cp = e->cp_cap = 0;
+    e->policy_data = NULL;
+    e->smp.ncpu = 1;
+    e->smp.global_queue = e->smp.steal = 0;
+    e->cost.cost = e->cost.warmup = 0;
+    e->sw = NULL;
+    e->stream = NULL;
+    e->seq = NULL;
+    e->admitted = 0;
+    e->cls = NULL;
+    memset(&e->overhead, 0, sizeof(e->overhead));
+#ifdef PROFILE
+    memset(&e->prof, 0, sizeof(e->prof));
+#endif
+    memset(&e->stats, 0, sizeof(e->stats));
+    return 1;
+}
+
+void engine_free(Engine *e) {
+    arena_reset(e->arena, e->mark);
+    e->order = NULL;
+    e->start = e->finish = NULL;
+}
+
+static int add_checkpoint(Engine *e, const Checkpoint *c) {
+    if(e->nb_cp == e->cp_cap) {
+        int cap = e->cp_cap ? e->cp_cap * 2 : 64;
+        Checkpoint *bigger = arena_alloc(e->arena, sizeof(Checkpoint) * cap);
+        if(!bigger) return 0;
+        if(e->nb_cp) memcpy(bigger, e->cp, sizeof(Checkpoint) * e->nb_cp);
+        e->cp = bigger;
+        e->cp_cap = cap;
+    }
+    e->cp[e->nb_cp++] = *c;
+    return 1;
+}
+
+// Point de prev : son image est recopiée, elle doit survivre à prev
+static int copy_checkpoint(Engine *e, const Checkpoint *c) {
+    Checkpoint copy = *c;
+    if(c->image) {
+        copy.image = arena_alloc(e->arena, c->image_len);
+        if(!copy.image) return 0;
+        memcpy(copy.image, c->image, c->image_len);
+    }
+    return add_checkpoint(e, &copy);
+}
+
+static int same_process(const Engine *e, const Engine *prev, int k) {
+    int i = e->order[k];
+    if(prev->order[k] != i) return 0;
+    const Process *a = &e->p[i], *b = &prev->p[i];
+    return a->arrival == b->arrival && a->burst == b->burst && a->priority == b->priority
+        && strcmp(a->name, b->name) == 0
+        && a->nio == b->nio && (a->nio == 0 || memcmp(a->io, b->io, sizeof(IoBurst) * a->nio) == 0);
+}
+
+/*
+ * Les processus du préfixe commun (même rang d'arrivée, même indice, mêmes
+ * champs) ont le même destin jusqu'au dernier point de reprise qu'ils
+ * couvrent, à condition que le premier processus nouveau arrive après. Ceux
+ * qui tournaient encore à un point en pleine charge sont rechargés de son
+ * image par engine_run.
+ */
+int engine_resume(Engine *e, const Engine *prev) {
+    int common = 0, m = e->n < prev->n ? e->n : prev->n;
+    while(common < m && same_process(e, prev, common)) common++;
+
+    int k = prev->nb_cp - 1;
+    for(; k >= 0; k--) {
+        const Checkpoint *c = &prev->cp[k];
+        if(c->next > common) continue;
+        if(c->next < e->n && e->p[e->order[c->next]].arrival <= c->time) continue;
+        // L'image suppose des E/S des deux côtés ou d'aucun
+        if(c->image && !e->io != !prev->io) continue;
+        break;
+    }
+    if(k < 0) return 1;
+
+    const Checkpoint *c = &prev->cp[k];
+    for(int j = 0; j < c->next; j++) {
+        int i = e->order[j];
+        e->start[i] = prev->start[i];
+        e->finish[i] = prev->finish[i];
+        e->p[i].remaining = 0;
+        if(e->io && prev->io) {
+            e->io->blocked[i] = prev->io->blocked[i];
+            e->io->response[i] = prev->io->response[i];
+        }
+    }
+    for(int j = 0; j < c->segments; j++) {
+        const Segment *seg = &prev->sched.seg[j];
+        if(!schedule_add(&e->sched, seg->proc, seg->start, seg->end, seg->level)) return 0;
+    }
+    // En pleine charge, prev a pu prolonger le dernier segment au-delà du point
+    if(e->sched.count > 0 && e->sched.seg[e->sched.count - 1].end > c->time)
+        e->sched.seg[e->sched.count - 1].end = c->time;
+    // Un point d'inactivité sera réenregistré par engine_run, pas un point en pleine charge
+    if(e->checkpointing)
+        for(int j = 0; j < (c->image ? k + 1 : k); j++)
+            if(!copy_checkpoint(e, &prev->cp[j])) return 0;
+
+    e->first = c->next;
+    e->done = c->done;
+    e->image = c->image;   // relue par engine_run tant que prev est là
+    e->time = c->time;
+    e->events = c->events;
+    e->rng = c->rng;
+    e->overhead = c->overhead;
+    return 1;
+}
+
+// Les cases sont recyclées : les égalités se tranchent par ordre d'admission, comme sur la table complète
+int engine_stream(Engine *e, Stream *s) {
+    e->stream = s;
+    e->checkpointing = 0;
+    e->seq = arena_alloc(e->arena, sizeof(long long) * (e->n > 0 ? e->n : 1));
+    e->admitted = 0;
+    return e->seq && io_init(e);
+}
+
+// La prochaine arrivée du flux prend une case : rien de son occupant précédent ne doit rester
+static int admit(Engine *e) {
+    int i = stream_admit(e->stream);
+    if(i < 0) return -1;
+
+    e->seq[i] = e->admitted++;
+    e->start[i] = e->finish[i] = -1;
+    e->p[i].remaining = process_first_burst(&e->p[i]);
+    io_reset(e, i);
+    switch_reset(e, i);
+    if(e->cls->reset) e->cls->reset(e, i);
+    return i;
+}
+
+static long long next_arrival(const Engine *e, int next) {
+    if(e->stream) return stream_peek(e->stream);
+    return next < e->n ? e->p[e->order[next]].arrival : LLONG_MAX;
+}
+
+int engine_next_ready(Engine *e, int *next, long long now) {
+    long long arrival = next_arrival(e, *next);
+    long long wake = io_next_wake(e);
+
+    if(arrival <= now && arrival <= wake) return e->stream ? admit(e) : e->order[(*next)++];
+    if(wake <= now) return io_wake(e);
+    return -1;
+}
+
+long long engine_next_event(const Engine *e, int next) {
+    long long arrival = next_arrival(e, next);
+    long long wake = io_next_wake(e);
+    return arrival < wake ? arrival : wake;
+}
+
+/*
+ * Boucle à événements : le temps saute directement à la prochaine arrivée,
+ * fin d'E/S, fin de processus ou expiration de tranche. Le coût dépend du
+ * nombre d'événements, pas de la durée simulée.
+ */
+int engine_run(Engine *e, const SchedClass *cls, void *rq) {
+    Process *p = e->p;
+    int next = e->first, done = e->done, oldest = 0, j;
+    long long last_cp = e->events;
+    size_t images = 0;
+
+    e->rq = rq;
+    if(e->image) engine_restore(e);
+    for(int k = 0; k < e->nb_cp; k++)
+        images += e->cp[k].image_len;
+
+    // En flux, le nombre de processus n'est pas connu : la boucle s'arrête quand tout est vide
+    while(done < e->n || e->stream) {
+        while((j = engine_next_ready(e, &next, e->time)) >= 0) {
+            cls->enqueue(e, j);
+            PROF_COUNT(e, queue_ops);
+        }
+
+        // En pleine charge : les processus en cours sont entre le plus ancien non terminé et next.
+        // Les parcourir coûte au plus CP_SCAN accès par événement depuis le point précédent.
+        if(e->checkpointing && cls->snapshot) {
+            long long since = e->events - last_cp;
+            while(oldest < next && e->finish[e->order[oldest]] >= 0) oldest++;
+            if(since >= CP_EVENTS && since * CP_SCAN >= next - oldest) {
+                Checkpoint c = { next, e->time, e->events, e->sched.count, e->rng, e->overhead, done, NULL, 0 };
+                c.image_len = engine_image_size(e, next - done);
+                if(images + c.image_len <= CP_IMAGES * sizeof(Segment) * (size_t)e->sched.count) {
+                    if(!engine_snapshot(e, oldest, next, done, &c) || !add_checkpoint(e, &c)) return 0;
+                    images += c.image_len;
+                }
+                last_cp = e->events;
+            }
+        }
+
+        e->level = 0;
+        int i = cls->pick_next(e);
+        e->events++;
+        PROF_COUNT(e, queue_ops);
+
+        if(i < 0) {
+            long long t = engine_next_event(e, next);
+            if(t == LLONG_MAX) break;
+            PROF_COUNT(e, idle_skips);
+            PROF_ADD(e, idle_time, t - e->time);
+            // La reprise refait ce choix vide : il n'est pas encore compté.
+            // Pas de point de reprise tant qu'un processus est bloqué.
+            if(e->checkpointing && io_next_wake(e) == LLONG_MAX) {
+                Checkpoint c = { next, e->time, e->events - 1, e->sched.count, e->rng, e->overhead, done, NULL, 0 };
+                if(!add_checkpoint(e, &c)) return 0;
+            }
+            e->time = t;
+            continue;
+        }
+
+        // Commutation : le temps passe, les arrivées de l'intervalle sont livrées et
+        // une politique préemptive peut reprendre la main dès la fin de la commutation.
+        // La tranche est fixée avant : la politique la calcule sur la file d'où i sort (comme dispatch en SMP).
+        int arrived = 0;
+        long long cost = switch_in(e, 0, i);
+        long long slice = cls->slice(e, i) + switch_warmup(e, i);
+        if(cost > 0) {
+            e->time += cost;
+            while((j = engine_next_ready(e, &next, e->time)) >= 0) {
+                cls->enqueue(e, j);
+                PROF_COUNT(e, queue_ops);
+                arrived = 1;
+            }
+        }
+        PROF_COUNT(e, decisions);
+
+        long long end = e->time + slice;
+        if(cls->preemptive) {
+            long long t = arrived ? e->time : engine_next_event(e, next);
+            if(t < end) {
+                end = t;
+                PROF_COUNT(e, preemptions);
+            }
+        }
+
+        engine_dispatch(e, i, e->time);
+        if(e->stream) stream_ran(e, i, e->time, end);
+        else if(end > e->time && !schedule_add(&e->sched, i, e->time, end, e->level))
+            return 0;
+
+        long long ran = end - e->time;
+        p[i].remaining -= (int)switch_out(e, 0, i, ran);
+        e->time = end;
+
+        // Fin du processus notée avant de lire plus loin : en flux, sa ligne n'attend pas l'entrée suivante
+        int finished = p[i].remaining == 0 && !io_pending(e, i);
+        if(finished) {
+            e->finish[i] = e->time;
+            done++;
+            if(e->stream) stream_retire(e, i);
+        }
+
+        while((j = engine_next_ready(e, &next, e->time)) >= 0) {
+            cls->enqueue(e, j);
+            PROF_COUNT(e, queue_ops);
+        }
+
+        // Fin de rafale suivie d'une E/S : après les arrivées, qui passent avant lui au périphérique
+        if(p[i].remaining == 0 && !finished) io_block(e, i, e->time);
+        if(cls->put_prev) {
+            cls->put_prev(e, i, ran);
+            PROF_COUNT(e, queue_ops);
+        }
+        if(finished && e->stream) stream_release(e, i);
+    }
+    e->horizon = e->time;
+    return 1;
+}
+
+void *heap_create(Engine *e, int quantum) {
+    MinHeap *h = arena_alloc(e->arena, sizeof(MinHeap));
+    if(!h || !heap_init(h, e->n, e->arena)) return NULL;
+    h->rank = e->seq;
+    return h;
+}
+
+void heap_snapshot(Engine *e, Snapshot *s) {
+    snap_heap(s, e->rq);
+}
+
+int engine_simulate(Engine *e, const SchedClass *cls, int quantum) {
+    e->cls = cls;
+    if(!switch_init(e)) return 0;
+    if(e->smp.ncpu > 1) return smp_run(e, cls, quantum);
+    void *rq = cls->create(e, quantum);
+    return rq && engine_run(e, cls, rq);
+}
@@ -1,75 +1,45 @@
-#include <stdio.h>
-#include <string.h>
 #include "../include/process.h"
-#include "../include/colors.h"
-
-void fifo(Process p[], int n) {
-    int waiting[n], turnaround[n];
-
-    for(int i = 0; i < n-1; i++) {
-        for(int j = i+1; j < n; j++) {
-            if(p[i].arrival > p[j].arrival) {
-                Process tmp = p[i];
-                p[i] = p[j];
-                p[j] = tmp;
-            }
-        }
-    }
-
-    int total_time = 0;
-    for(int i = 0; i < n; i++) {
-        if(total_time < p[i].arrival)
-            total_time = p[i].arrival;
-        total_time += p[i].burst;
-    }
-
-    for(int i = 0; i < n; i++) {
-        waiting[i] = 0;
-        turnaround[i] = 0;
-    }
-
-    printf("\n================ FIFO Scheduler =================\n");
-
-    printf("%-5s %-10s %-8s %-6s\n", "ID", "Process", "Arrival", "Burst");
-    printf("-----------------------------------------------\n");
-    for(int i = 0; i < n; i++) {
-        printf("%-5d %-10s %-8d %-6d\n", i+1, p[i].name, p[i].arrival, p[i].burst);
-    }
-
-    printf("\nGantt Chart:\n");
-
-    printf("Time : ");
-    for(int t = 0; t < total_time; t++)
-        printf("%2d ", t);
-    printf("\n");
-
-    int gantt_time = 0;
-    for(int i = 0; i < n; i++) {
-        printf("%-6s: ", p[i].name);
-
-        for(int t = 0; t < total_time; t++) {
-            if(t >= gantt_time && t < gantt_time + p[i].burst) {
-                printf("%s█%s ", colors[i % 6], RESET);
-            } else {
-                printf(" . ");
-            }
-        }
-        printf("\n");
-
-        if(gantt_time < p[i].arrival)
-            gantt_time = p[i].arrival;
-        gantt_time += p[i].burst;
-
-        waiting[i] = gantt_time - p[i].arrival - p[i].burst;
-        turnaround[i] = gantt_time - p[i].arrival;
-    }
-
-    printf("\nSummary:\n");
-    printf("%-10s %-10s %-10s\n", "Process", "Waiting", "Turnaround");
-    for(int i = 0; i < n; i++) {
-        printf("%-10s %-10d %-10d\n", p[i].name, waiting[i], turnaround[i]);
-    }
-
-    printf("================================================\n");
-    printf("End of FIFO scheduling.\n\n");
-}
\ No newline at end of file
+#include "../include/engine.h"
+
+// File circulaire : un processus qui revient d'E/S est remis en file
+typedef struct {
+    int *queue;
+    int size, head, count;
+} FifoQueue;
+
+static void fifo_enqueue(Engine *e, int i) {
+    FifoQueue *q = e->rq;
+    q->queue[(q->head + q->count++) % q->size] = i;
+}
+
+static int fifo_pick_next(Engine *e) {
+    FifoQueue *q = e->rq;
+    if(q->count == 0) return -1;
+    int idx = q->queue[q->head];
+    q->head = (q->head + 1) % q->size;
+    q->count--;
+    return idx;
+}
+
+static long long fifo_slice(Engine *e, int i) {
+    return e->p[i].remaining;
+}
+
+static void *fifo_create(Engine *e, int quantum) {
+    FifoQueue *q = arena_alloc(e->arena, sizeof(FifoQueue));
+    if(!q || !(q->queue = arena_alloc(e->arena, sizeof(int) * e->n))) return NULL;
+    q->size = e->n > 0 ? e->n : 1;
+    q->head = q->count = 0;
+    return q;
+}
+
+static void fifo_snapshot(Engine *e, Snapshot *s) {
+    FifoQueue *q = e->rq;
+    snap_ring(s, q->queue, q->size, &q->head, &q->count);
+}
+
+static const SchedClass fifo_class = { 0, fifo_create, fifo_enqueue, fifo_pick_next, fifo_slice, NULL, NULL, NULL, fifo_snapshot };
+
+int fifo(Engine *e, int quantum) {
+    return engine_simulate(e, &fifo_class, quantum);
+}
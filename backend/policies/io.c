@@ -0,0 +1,95 @@
+#include "../include/engine.h"
+#include "../include/heap.h"
+
+/*
+ * E/S : un processus qui termine une rafale CPU avant sa dernière passe à
+ * l'état bloqué sur son périphérique. Chaque périphérique sert ses demandes
+ * une à une, dans l'ordre d'arrivée ; le tas des périphériques occupés donne
+ * la prochaine fin d'E/S, qui rend le processus à la politique par enqueue.
+ */
+int io_init(Engine *e) {
+    int ndev = 0;
+    e->io = NULL;
+    for(int i = 0; i < e->n; i++)
+        for(int k = 0; k < e->p[i].nio; k++)
+            if(e->p[i].io[k].device >= ndev) ndev = e->p[i].io[k].device + 1;
+    // En flux, les E/S à venir sont inconnues : tous les périphériques sont prévus
+    if(e->stream) ndev = MAX_DEVICES;
+    if(ndev == 0) return 1;
+
+    Arena *a = e->arena;
+    IoState *io = arena_alloc(a, sizeof(IoState));
+    if(!io) return 0;
+    io->dev = arena_alloc(a, sizeof(IoDevice) * ndev);
+    io->phase = arena_calloc(a, e->n, sizeof(int));
+    io->next = arena_alloc(a, sizeof(int) * e->n);
+    io->blocked = arena_calloc(a, e->n, sizeof(long long));
+    io->since = arena_alloc(a, sizeof(long long) * e->n);
+    io->ready = arena_alloc(a, sizeof(long long) * e->n);
+    io->response = arena_calloc(a, e->n, sizeof(long long));
+    if(!io->dev || !io->phase || !io->next || !io->blocked || !io->since || !io->ready || !io->response
+       || !heap_init(&io->wake, ndev, a))
+        return 0;
+    for(int i = 0; i < e->n; i++)
+        io->ready[i] = -1;
+    for(int d = 0; d < ndev; d++)
+        io->dev[d].current = io->dev[d].head = io->dev[d].tail = -1;
+    io->ndev = ndev;
+    e->io = io;
+    return 1;
+}
+
+static void start(IoState *io, int d, int i, const Process *p, long long now) {
+    io->dev[d].current = i;
+    heap_push(&io->wake, d, now + p->io[io->phase[i] - 1].length);
+}
+
+int io_block(Engine *e, int i, long long now) {
+    IoState *io = e->io;
+    if(!io || io->phase[i] == e->p[i].nio) return 0;
+
+    int d = e->p[i].io[io->phase[i]++].device;
+    IoDevice *dev = &io->dev[d];
+    io->since[i] = now;
+    if(dev->current < 0) {
+        start(io, d, i, &e->p[i], now);
+    } else {
+        io->next[i] = -1;
+        if(dev->tail < 0) dev->head = i;
+        else io->next[dev->tail] = i;
+        dev->tail = i;
+    }
+    return 1;
+}
+
+int io_wake(Engine *e) {
+    IoState *io = e->io;
+    int d = heap_top(&io->wake);
+    long long now = io->wake.key[d];
+    IoDevice *dev = &io->dev[d];
+    int i = dev->current;
+
+    heap_pop(&io->wake);
+    io->blocked[i] += now - io->since[i];
+    io->ready[i] = now;
+    e->p[i].remaining = e->p[i].io[io->phase[i] - 1].cpu;
+
+    // Le suivant de la file commence à la fin de l'E/S, pas à la date du moteur
+    dev->current = -1;
+    if(dev->head >= 0) {
+        int j = dev->head;
+        dev->head = io->next[j];
+        if(dev->head < 0) dev->tail = -1;
+        start(io, d, j, &e->p[j], now);
+    }
+    return i;
+}
+
+// Case réutilisée (flux) : aucune E/S commencée
+void io_reset(Engine *e, int i) {
+    IoState *io = e->io;
+    if(!io) return;
+    io->phase[i] = 0;
+    io->blocked[i] = io->response[i] = 0;
+    io->ready[i] = -1;
+}
@@ -0,0 +1,63 @@
+#include "../include/process.h"
+#include "../include/engine.h"
+#include "../include/fenwick.h"
+#include "../include/nice.h"
+#include "../include/rng.h"
+
+/*
+ * Loterie : chaque prêt détient des billets (le poids tiré de sa priorité,
+ * comme pour CFS) et chaque quantum revient au détenteur d'un billet tiré au
+ * hasard. L'arbre de Fenwick des billets en file donne le gagnant en
+ * O(log n). Le générateur est celui du moteur : même graine, même tirage.
+ */
+typedef struct {
+    Fenwick tickets;
+    int quantum;
+} LotteryQueue;
+
+static void lottery_enqueue(Engine *e, int i) {
+    LotteryQueue *q = e->rq;
+    fenwick_add(&q->tickets, i, nice_weight(e->p[i].priority));
+}
+
+static int lottery_pick_next(Engine *e) {
+    LotteryQueue *q = e->rq;
+    if(q->tickets.total == 0) return -1;
+
+    int i = fenwick_find(&q->tickets, (long long)rng_below(&e->rng, (unsigned long long)q->tickets.total));
+    fenwick_add(&q->tickets, i, -nice_weight(e->p[i].priority));
+    return i;
+}
+
+static long long lottery_slice(Engine *e, int i) {
+    LotteryQueue *q = e->rq;
+    return e->p[i].remaining > q->quantum ? q->quantum : e->p[i].remaining;
+}
+
+static void lottery_put_prev(Engine *e, int i, long long ran) {
+    if(e->p[i].remaining > 0)
+        lottery_enqueue(e, i);
+}
+
+static void *lottery_create(Engine *e, int quantum) {
+    LotteryQueue *q = arena_alloc(e->arena, sizeof(LotteryQueue));
+    if(!q || !fenwick_init(&q->tickets, e->n, e->arena)) return NULL;
+    q->quantum = quantum;
+    return q;
+}
+
+// Billets en file de chaque processus en cours, remis un à un au chargement
+static void lottery_snapshot(Engine *e, Snapshot *s) {
+    LotteryQueue *q = e->rq;
+    for(int k = 0; k < s->nlive; k++) {
+        long long tickets = s->mode == SNAP_SAVE ? fenwick_weight(&q->tickets, s->live[k]) : 0;
+        SNAP(s, tickets);
+        if(s->mode == SNAP_LOAD && tickets > 0) fenwick_add(&q->tickets, s->live[k], tickets);
+    }
+}
+
+static const SchedClass lottery_class = { 0, lottery_create, lottery_enqueue, lottery_pick_next, lottery_slice, lottery_put_prev, NULL, NULL, lottery_snapshot };
+
+int lottery(Engine *e, int quantum) {
+    return engine_simulate(e, &lottery_class, quantum);
+}
@@ -0,0 +1,219 @@
+#include "../include/process.h"
+#include "../include/engine.h"
+#include "../include/bitmap.h"
+
+/*
+ * File multiniveau à retour : e->levels files FIFO, le niveau 0 est le plus
+ * prioritaire. Un processus entre au niveau de sa priorité, descend d'un
+ * niveau quand il consomme tout le quantum du sien (qui double à chaque
+ * niveau) et remonte par vieillissement. Le bitmap des niveaux non vides
+ * donne le prochain niveau à servir sans parcourir les files.
+ */
+#define MLFQ_AGING_QUANTA 10   // un lot de vieillissement tous les 10 quanta du niveau 0
+#define MLFQ_MAX_SHIFT    10   // quantum plafonné à 1024 fois celui du niveau 0
+
+// État par processus, commun à toutes les files (SMP)
+typedef struct {
+    int *next;           // chaînage dans la file de son niveau
+    int *level;          // niveau à l'entrée ou à la coupure, -1 avant la première entrée
+    long long *used;     // part du quantum de niveau consommée avant une préemption ou une E/S
+} MlfqShared;
+
+typedef struct {
+    int *head, *tail;    // une FIFO par niveau, -1 si vide
+    Bitmap nonempty;
+    int levels;
+    int quantum;
+    long long batches;   // lots de vieillissement déjà appliqués
+    MlfqShared *sh;
+} MlfqQueue;
+
+static long long level_quantum(const MlfqQueue *q, int level) {
+    return (long long)q->quantum << (level < MLFQ_MAX_SHIFT ? level : MLFQ_MAX_SHIFT);
+}
+
+static void push_tail(MlfqQueue *q, int level, int i) {
+    q->sh->next[i] = -1;
+    if(q->head[level] < 0) {
+        q->head[level] = i;
+        bitmap_set(&q->nonempty, level);
+    } else {
+        q->sh->next[q->tail[level]] = i;
+    }
+    q->tail[level] = i;
+}
+
+static void push_head(MlfqQueue *q, int level, int i) {
+    q->sh->next[i] = q->head[level];
+    if(q->head[level] < 0) {
+        q->tail[level] = i;
+        bitmap_set(&q->nonempty, level);
+    }
+    q->head[level] = i;
+}
+
+static int pop_head(MlfqQueue *q, int level) {
+    int i = q->head[level];
+    q->head[level] = q->sh->next[i];
+    if(q->head[level] < 0) {
+        q->tail[level] = -1;
+        bitmap_clear(&q->nonempty, level);
+    }
+    return i;
+}
+
+// La file from passe en bloc à la fin de la file to
+static void splice(MlfqQueue *q, int from, int to) {
+    if(q->head[to] < 0) {
+        q->head[to] = q->head[from];
+        bitmap_set(&q->nonempty, to);
+    } else {
+        q->sh->next[q->tail[to]] = q->head[from];
+    }
+    q->tail[to] = q->tail[from];
+    q->head[from] = q->tail[from] = -1;
+    bitmap_clear(&q->nonempty, from);
+}
+
+/*
+ * Vieillissement par lots : à chaque fin de période, les processus en
+ * attente montent de e->aging niveaux. Les lots échus sont appliqués avant
+ * toute opération sur les files, file par file : le coût dépend du nombre de
+ * niveaux non vides, pas du nombre de processus.
+ */
+static void age(Engine *e, MlfqQueue *q) {
+    long long due = e->time / ((long long)q->quantum * MLFQ_AGING_QUANTA);
+    if(due <= q->batches) return;
+
+    long long shift = (due - q->batches) * e->aging;
+    q->batches = due;
+    for(int l = bitmap_next(&q->nonempty, 1); l >= 0; l = bitmap_next(&q->nonempty, l + 1))
+        splice(q, l, shift >= l ? 0 : l - (int)shift);
+}
+
+static void mlfq_enqueue(Engine *e, int i) {
+    MlfqQueue *q = e->rq;
+    MlfqShared *sh = q->sh;
+    int level = sh->level[i];
+
+    age(e, q);
+    if(level < 0) {
+        int p = e->p[i].priority;
+        level = p < 0 ? 0 : p >= q->levels ? q->levels - 1 : p;
+        sh->level[i] = level;
+        sh->used[i] = 0;
+    }
+    push_tail(q, level, i);
+}
+
+static int mlfq_pick_next(Engine *e) {
+    MlfqQueue *q = e->rq;
+
+    age(e, q);
+    int level = bitmap_first(&q->nonempty);
+    if(level < 0) return -1;
+
+    int i = pop_head(q, level);
+    // Remonté par vieillissement depuis sa coupure : quantum neuf à son nouveau niveau
+    if(q->sh->level[i] != level) q->sh->used[i] = 0;
+    q->sh->level[i] = level;
+    e->level = level + 1;
+    return i;
+}
+
+static long long mlfq_slice(Engine *e, int i) {
+    MlfqQueue *q = e->rq;
+    long long slice = level_quantum(q, q->sh->level[i]) - q->sh->used[i];
+    return slice < e->p[i].remaining ? slice : e->p[i].remaining;
+}
+
+static void mlfq_put_prev(Engine *e, int i, long long ran) {
+    MlfqQueue *q = e->rq;
+    MlfqShared *sh = q->sh;
+    int level = sh->level[i];
+
+    age(e, q);
+    sh->used[i] += ran;
+
+    // Coupé par une arrivée : reprend en tête de son niveau. Parti en E/S avant
+    // la fin de son quantum : garde niveau et consommation, qui s'ajoute à la
+    // suivante (sinon une E/S juste avant l'échéance le garderait en haut).
+    if(sh->used[i] < level_quantum(q, level)) {
+        if(e->p[i].remaining > 0) push_head(q, level, i);
+        return;
+    }
+    sh->used[i] = 0;
+    if(level + 1 < q->levels) level++;
+    sh->level[i] = level;
+    if(e->p[i].remaining > 0) push_tail(q, level, i);
+}
+
+// Vol : le premier du niveau le moins prioritaire, qui garde son niveau
+static int mlfq_steal(Engine *e) {
+    MlfqQueue *q = e->rq;
+
+    age(e, q);
+    int level = bitmap_last(&q->nonempty);
+    if(level < 0) return -1;
+
+    int i = pop_head(q, level);
+    if(q->sh->level[i] != level) q->sh->used[i] = 0;
+    q->sh->level[i] = level;
+    return i;
+}
+
+static void *mlfq_create(Engine *e, int quantum) {
+    Arena *a = e->arena;
+    MlfqQueue *q = arena_alloc(a, sizeof(MlfqQueue));
+    if(!q) return NULL;
+
+    q->levels = e->levels;
+    q->quantum = quantum;
+    q->batches = 0;
+    q->head = arena_alloc(a, sizeof(int) * q->levels);
+    q->tail = arena_alloc(a, sizeof(int) * q->levels);
+    if(!q->head || !q->tail || !bitmap_init(&q->nonempty, q->levels, a)) return NULL;
+    for(int l = 0; l < q->levels; l++)
+        q->head[l] = q->tail[l] = -1;
+
+    if(!e->policy_data) {
+        MlfqShared *sh = arena_alloc(a, sizeof(MlfqShared));
+        if(!sh) return NULL;
+        sh->next = arena_alloc(a, sizeof(int) * e->n);
+        sh->level = arena_alloc(a, sizeof(int) * e->n);
+        sh->used = arena_calloc(a, e->n, sizeof(long long));
+        if(!sh->next || !sh->level || !sh->used) return NULL;
+        for(int i = 0; i < e->n; i++)
+            sh->level[i] = -1;
+        e->policy_data = sh;
+    }
+    q->sh = e->policy_data;
+    return q;
+}
+
+static void mlfq_reset(Engine *e, int i) {
+    MlfqShared *sh = e->policy_data;
+    sh->level[i] = -1;
+}
+
+// Le bitmap se déduit des têtes de file
+static void mlfq_snapshot(Engine *e, Snapshot *s) {
+    MlfqQueue *q = e->rq;
+    MlfqShared *sh = q->sh;
+
+    SNAP(s, q->batches);
+    snap_bytes(s, q->head, sizeof(int) * q->levels);
+    snap_bytes(s, q->tail, sizeof(int) * q->levels);
+    SNAP_LIVE(s, sh->next);
+    SNAP_LIVE(s, sh->level);
+    SNAP_LIVE(s, sh->used);
+    if(s->mode == SNAP_LOAD)
+        for(int l = 0; l < q->levels; l++)
+            if(q->head[l] >= 0) bitmap_set(&q->nonempty, l);
+}
+
+static const SchedClass mlfq_class = { 1, mlfq_create, mlfq_enqueue, mlfq_pick_next, mlfq_slice, mlfq_put_prev, mlfq_steal, mlfq_reset, mlfq_snapshot };
+
+int mlfq(Engine *e, int quantum) {
+    return engine_simulate(e, &mlfq_class, quantum);
+}
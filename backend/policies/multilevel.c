@@ -1,149 +1,169 @@
-#include <stdio.h>
+#include <string.h>
 #include "../include/process.h"
-#include "../include/colors.h"
+#include "../include/engine.h"
+#include "../include/heap.h"
 
-void multilevel(Process p[], int n, int quantum) {
+/*
+ * Niveau 1 : un seul processus a la plus petite priorité vieillie, il tourne
+ * et vieillit de e->aging par tick. Niveau 2 : plusieurs sont à égalité, ils
+ * passent chacun un quantum en tourniquet, sans tenir compte des arrivées,
+ * puis vieillissent de e->aging. Les prêts hors du lot sont dans un tas par
+ * (priorité vieillie, admission) : le lot est la suite des minimums égaux.
+ */
+typedef struct {
+    MinHeap ready;
+    int *priority;       // priorités vieillies, communes à toutes les files (SMP)
+    long long *used;     // part du quantum consommée par membre du lot, idem
+    int *batch;
+    int batch_len, batch_pos;
+    int quantum;
+} MultilevelQueue;
 
-    int remaining[n], priority[n], waiting[n], turnaround[n], arrival_time[n];
-    int time = 0, completed = 0;
+typedef struct {
+    int *priority;
+    long long *used;
+} MultilevelShared;
 
-    for(int i = 0; i < n; i++) {
-        remaining[i] = p[i].burst;
-        priority[i] = p[i].priority;
-        waiting[i] = 0;
-        turnaround[i] = 0;
-        arrival_time[i] = p[i].arrival;
+static void ml_enqueue(Engine *e, int i) {
+    MultilevelQueue *q = e->rq;
+    heap_push(&q->ready, i, q->priority[i]);
+}
+
+static int ml_pick_next(Engine *e) {
+    MultilevelQueue *q = e->rq;
+
+    if(q->batch_pos < q->batch_len) {
+        // Le membre est pris tout de suite : un autre CPU de la file passe au suivant
+        e->level = 2;
+        return q->batch[q->batch_pos++];
     }
 
-    printf("\n================ Multi-Level avec aging (Quantum = %d) =================\n", quantum);    
-    printf("%-5s %-10s %-8s %-6s %-8s\n", "ID", "Process", "Arrival", "Burst", "Priority");
-    printf("-----------------------------------------------------------------\n");
-    for(int i = 0; i < n; i++)
-        printf("%-5d %-10s %-8d %-6d %-8d\n", i+1, p[i].name, p[i].arrival, p[i].burst, p[i].priority);
+    if(heap_empty(&q->ready)) return -1;
 
-    printf("\nGantt Chart:\n");
+    // Les égaux sortent du tas par ordre d'admission
+    long long min_priority = q->ready.key[heap_top(&q->ready)];
+    q->batch_len = 0;
+    q->batch_pos = 0;
+    while(!heap_empty(&q->ready) && q->ready.key[heap_top(&q->ready)] == min_priority)
+        q->batch[q->batch_len++] = heap_pop(&q->ready);
 
-    int total_time = 0;
-    for(int i = 0; i < n; i++) {
-        if(total_time < p[i].arrival) total_time = p[i].arrival;
-        total_time += p[i].burst;
+    if(q->batch_len == 1) {
+        q->batch_len = 0;
+        e->level = 1;
+        return q->batch[0];
     }
 
-    int timeline[total_time];
-    int timeline_level1[total_time];
-    int timeline_level2[total_time];
-    for(int i = 0; i < total_time; i++) {
-        timeline[i] = -1;
-        timeline_level1[i] = -1;
-        timeline_level2[i] = -1;
-    }
+    for(int k = 0; k < q->batch_len; k++)
+        q->used[q->batch[k]] = 0;
+    return ml_pick_next(e);
+}
 
-    time = 0;
-    completed = 0;
-    for(int i = 0; i < n; i++) {
-        remaining[i] = p[i].burst;
-        priority[i] = p[i].priority;
+// Membre coupé avant la fin de son quantum : il repasse en tête du lot. Les
+// cases avant batch_pos sont consommées ; si un autre CPU a entre-temps
+// formé un nouveau lot (file globale), on décale.
+static void batch_resume(MultilevelQueue *q, int i) {
+    if(q->batch_pos == 0) {
+        memmove(q->batch + 1, q->batch, sizeof(int) * q->batch_len);
+        q->batch_len++;
+        q->batch_pos = 1;
     }
+    q->batch[--q->batch_pos] = i;
+}
 
-    while(completed < n) {
-        int min_priority = 1000;
-        int count_min = 0;
-        int indices[n];
-        for(int i = 0; i < n; i++) {
-            if(remaining[i] > 0 && p[i].arrival <= time) {
-                if(priority[i] < min_priority) {
-                    min_priority = priority[i];
-                    count_min = 1;
-                    indices[0] = i;
-                } else if(priority[i] == min_priority) {
-                    indices[count_min++] = i;
-                }
-            }
-        }
+static long long ml_slice(Engine *e, int i) {
+    MultilevelQueue *q = e->rq;
+    long long slice = e->p[i].remaining;
 
-        if(count_min == 0) {
-            timeline[time] = -1;
-            timeline_level1[time] = -1;
-            timeline_level2[time] = -1;
-            time++;
-            continue;
-        }
+    if(e->level == 2) {
+        if(slice > q->quantum - q->used[i]) slice = q->quantum - q->used[i];
+        return slice;
+    }
 
-        if(count_min == 1) {
-            int i = indices[0];
-            timeline[time] = i;
-            timeline_level1[time] = i;
-            timeline_level2[time] = -1;
-            remaining[i]--;
-            priority[i]++;
-            for(int j = 0; j < n; j++)
-                if(j != i && remaining[j] > 0 && p[j].arrival <= time)
-                    waiting[j]++;
-            if(remaining[i] == 0)
-                turnaround[i] = time + 1 - arrival_time[i], completed++;
-            time++;
-        } else {
-            int q = quantum;
-            for(int k = 0; k < count_min; k++) {
-                int i = indices[k];
-                int t = 0;
-                while(t < q && remaining[i] > 0) {
-                    timeline[time] = i;
-                    timeline_level1[time] = -1;
-                    timeline_level2[time] = i;
-                    remaining[i]--;
-                    for(int j = 0; j < n; j++)
-                        if(j != i && remaining[j] > 0 && p[j].arrival <= time)
-                            waiting[j]++;
-                    t++;
-                    time++;
-                    if(remaining[i] == 0) {
-                        turnaround[i] = time - arrival_time[i];
-                        completed++;
-                        break;
-                    }
-                }
-                priority[i]++;
-            }
-        }
+    // Le processus garde le CPU jusqu'à rejoindre la priorité suivante
+    if(!heap_empty(&q->ready)) {
+        long long gap = q->ready.key[heap_top(&q->ready)] - q->priority[i];
+        gap = gap > 0 ? (gap + e->aging - 1) / e->aging : 0;
+        if(gap < slice) slice = gap;
     }
+    return slice;
+}
 
-    printf("\n");
-    for(int proc = 0; proc < n; proc++) {
-        printf("%-6s: ", p[proc].name);
-        for(int t = 0; t < time; t++) {
-            if(timeline[t] == proc)
-                printf("%s█%s ", colors[proc % 6], RESET);
-            else
-                printf(" . ");
+static void ml_put_prev(Engine *e, int i, long long ran) {
+    MultilevelQueue *q = e->rq;
+
+    if(e->level == 1) {
+        q->priority[i] += (int)ran * e->aging;
+    } else {
+        q->used[i] += ran;
+        if(q->used[i] < q->quantum && e->p[i].remaining > 0) {
+            batch_resume(q, i);
+            return;
         }
-        printf("\n");
+        q->priority[i] += e->aging;
     }
 
-    printf("\nTimeline by Level:\n       ");
-    for(int t = 0; t < time; t++)
-        printf("%-4d", t);
-    printf("\nLevel 1 ");
-    for(int t = 0; t < time; t++) {
-        if(timeline_level1[t] != -1)
-            printf("%-4s", p[timeline_level1[t]].name);
-        else
-            printf("    ");
+    if(e->p[i].remaining > 0)
+        ml_enqueue(e, i);
+}
+
+// Vol : le moins prioritaire des prêts hors du lot en cours, qui reste intact.
+// Parcours linéaire du tas : le placement équilibre les files, la victime en a
+// peu quand les vols sont fréquents, et un second tas coûterait à chaque ajout.
+static int ml_steal(Engine *e) {
+    MultilevelQueue *q = e->rq;
+    int best = -1;
+
+    for(int k = 0; k < q->ready.size; k++) {
+        int i = q->ready.heap[k];
+        if(best < 0 || q->priority[i] > q->priority[best] || (q->priority[i] == q->priority[best] && i > best))
+            best = i;
     }
-    printf("\nLevel 2 ");
-    for(int t = 0; t < time; t++) {
-        if(timeline_level2[t] != -1)
-            printf("%-4s", p[timeline_level2[t]].name);
-        else
-            printf("    ");
+    if(best >= 0) heap_remove(&q->ready, best);
+    return best;
+}
+
+static void *ml_create(Engine *e, int quantum) {
+    Arena *a = e->arena;
+    MultilevelQueue *q = arena_calloc(a, 1, sizeof(MultilevelQueue));
+    if(!q || !heap_init(&q->ready, e->n, a)) return NULL;
+    q->ready.rank = e->seq;
+    q->batch = arena_alloc(a, sizeof(int) * (e->n + 1));
+    q->quantum = quantum;
+
+    if(!e->policy_data) {
+        MultilevelShared *sh = arena_alloc(a, sizeof(MultilevelShared));
+        if(!sh) return NULL;
+        sh->priority = arena_alloc(a, sizeof(int) * e->n);
+        sh->used = arena_calloc(a, e->n, sizeof(long long));
+        if(!sh->priority || !sh->used) return NULL;
+        for(int i = 0; i < e->n; i++)
+            sh->priority[i] = e->p[i].priority;
+        e->policy_data = sh;
     }
-    printf("\n");
+    const MultilevelShared *sh = e->policy_data;
+    q->priority = sh->priority;
+    q->used = sh->used;
+    return q->batch ? q : NULL;
+}
+
+static void ml_reset(Engine *e, int i) {
+    MultilevelShared *sh = e->policy_data;
+    sh->priority[i] = e->p[i].priority;
+    sh->used[i] = 0;
+}
+
+static void ml_snapshot(Engine *e, Snapshot *s) {
+    MultilevelQueue *q = e->rq;
+    snap_heap(s, &q->ready);
+    SNAP_LIVE(s, q->priority);
+    SNAP_LIVE(s, q->used);
+    SNAP(s, q->batch_len);
+    SNAP(s, q->batch_pos);
+    snap_bytes(s, q->batch, sizeof(int) * q->batch_len);
+}
 
-    printf("\nSummary:\n");
-    printf("%-10s %-10s %-10s\n", "Process", "Waiting", "Turnaround");
-    for(int i = 0; i < n; i++)
-        printf("%-10s %-10d %-10d\n", p[i].name, waiting[i], turnaround[i]);
+static const SchedClass ml_class = { 1, ml_create, ml_enqueue, ml_pick_next, ml_slice, ml_put_prev, ml_steal, ml_reset, ml_snapshot };
 
-    printf("===============================================================\n");
-    printf("End of Multi-Level avec aging scheduling.\n\n");
-}
\ No newline at end of file
+int multilevel(Engine *e, int quantum) {
+    return engine_simulate(e, &ml_class, quantum);
+}
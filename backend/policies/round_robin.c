@@ -1,87 +1,52 @@
-#include <stdio.h>
 #include "../include/process.h"
-#include "../include/colors.h"
+#include "../include/engine.h"
 
-void round_robin_display(Process p[], int n, int quantum) {
-    int remaining[100], waiting[100], turnaround[100];
-    for(int i = 0; i < n; i++) remaining[i] = p[i].burst;
+typedef struct {
+    int *queue;
+    int size, head, count;
+    int quantum;
+} RoundRobinQueue;
 
-    printf("\n================ Round Robin Scheduler (Quantum = %d) =================\n", quantum);
-
-    printf("%-5s %-10s %-8s %-6s\n", "ID", "Process", "Arrival", "Burst");
-    printf("-------------------------------------------------\n");
-    for(int i = 0; i < n; i++)
-        printf("%-5d %-10s %-8d %-6d\n", i+1, p[i].name, p[i].arrival, p[i].burst);
-
-    int total_time = 0;
-    for(int i = 0; i < n; i++)
-        if(total_time < p[i].arrival) total_time = p[i].arrival;
-    for(int i = 0; i < n; i++) total_time += p[i].burst;
-
-    int queue[100], front = 0, rear = 0;
-    int completed = 0, time = 0;
-
-    for(int i = 0; i < n; i++)
-        if(p[i].arrival == 0)
-            queue[rear++] = i;
-
-    for(int i = 0; i < n; i++) waiting[i] = 0;
-
-    printf("\nGantt Chart:\n");
-
-    while(completed < n) {
-
-        if(front == rear) {
-            time++;
-            for(int i = 0; i < n; i++)
-                if(p[i].arrival == time)
-                    queue[rear++] = i;
-            continue;
-        }
-
-        int idx = queue[front++];
-        int exec = (remaining[idx] > quantum) ? quantum : remaining[idx];
+static void rr_enqueue(Engine *e, int i) {
+    RoundRobinQueue *q = e->rq;
+    q->queue[(q->head + q->count++) % q->size] = i;
+}
 
-        printf("%-6s: ", p[idx].name);
-        for(int t = 0; t < total_time; t++) {
-            if(t >= time && t < time + exec)
-                printf("%s█%s ", colors[idx % 6], RESET);
-            else
-                printf(" . ");
-        }
-        printf("\n");
+static int rr_pick_next(Engine *e) {
+    RoundRobinQueue *q = e->rq;
+    if(q->count == 0) return -1;
+    int idx = q->queue[q->head];
+    q->head = (q->head + 1) % q->size;
+    q->count--;
+    return idx;
+}
 
-        if(waiting[idx] == 0 && time > p[idx].arrival)
-            waiting[idx] = time - p[idx].arrival;
+static long long rr_slice(Engine *e, int i) {
+    RoundRobinQueue *q = e->rq;
+    return (e->p[i].remaining > q->quantum) ? q->quantum : e->p[i].remaining;
+}
 
-        remaining[idx] -= exec;
-        int old_time = time;
-        time += exec;
+static void rr_put_prev(Engine *e, int i, long long ran) {
+    if(e->p[i].remaining > 0)
+        rr_enqueue(e, i);
+}
 
-        for(int t = old_time + 1; t <= time; t++) {
-            for(int i = 0; i < n; i++) {
-                if(p[i].arrival == t)
-                    queue[rear++] = i;
-            }
-        }
+static void *rr_create(Engine *e, int quantum) {
+    RoundRobinQueue *q = arena_alloc(e->arena, sizeof(RoundRobinQueue));
+    if(!q || !(q->queue = arena_alloc(e->arena, sizeof(int) * e->n))) return NULL;
+    q->size = e->n > 0 ? e->n : 1;
+    q->head = q->count = 0;
+    q->quantum = quantum;
+    return q;
+}
 
-        if(remaining[idx] > 0)
-            queue[rear++] = idx;
-        else {
-            turnaround[idx] = time - p[idx].arrival;
-            completed++;
-        }
-    }
+static void rr_snapshot(Engine *e, Snapshot *s) {
+    RoundRobinQueue *q = e->rq;
+    snap_ring(s, q->queue, q->size, &q->head, &q->count);
+}
 
-    printf("\nSummary:\n");
-    printf("%-10s %-10s %-10s\n", "Process", "Waiting", "Turnaround");
-    for(int i = 0; i < n; i++)
-        printf("%-10s %-10d %-10d\n", p[i].name, waiting[i], turnaround[i]);
+static const SchedClass rr_class = { 0, rr_create, rr_enqueue, rr_pick_next, rr_slice, rr_put_prev, NULL, NULL, rr_snapshot };
 
-    printf("===============================================================\n");
-    printf("End of Round Robin scheduling.\n\n");
+int round_robin(Engine *e, int quantum) {
+    return engine_simulate(e, &rr_class, quantum);
 }
-
-void round_robin(Process p[], int n, int quantum) {
-    round_robin_display(p, n, quantum);
-}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <limits.h>
+#include <string.h>
+#include "../include/engine.h"
+#include "../include/heap.h"
+#include "../include/vecscan.h"
+
+/*
+ * Moteur multiprocesseur : une horloge commune à tous les CPU. Le prochain
+ * événement est la plus proche fin de tranche (tas des CPU occupés), la
+ * prochaine arrivée ou la prochaine fin d'E/S. La politique est inchangée : chaque CPU a sa propre
+ * instance de file (ou tous partagent la même en mode global), et e->rq
+ * désigne la file du CPU concerné avant chaque appel.
+ */
+typedef struct {
+    void *rq;
+    int current;         // processus en cours, -1 si inactif
+    long long since;     // début de la tranche en cours
+    int level;
+    int preempt;         // a reçu une arrivée : la tranche en cours est coupée
+} Cpu;
+
+typedef struct {
+    Engine *e;
+    const SchedClass *cls;
+    Cpu *cpu;
+    // Par CPU, contigus pour les recherches de place et de victime
+    int *queued;         // processus en attente dans la file (mode par CPU)
+    int *load;           // queued + 1 si occupé
+    int ncpu;
+    int global;
+    MinHeap running;     // CPU occupés, par date de fin de tranche
+    int *last_cpu;       // dernier CPU de chaque processus, -1 sinon
+    int done;
+} Smp;
+
+// Comme select_task_rq : un CPU libre à file vide, sinon le moins chargé
+static int place(const Smp *m) {
+    return m->global ? 0 : vec_argmin_int(m->load, m->ncpu);
+}
+
+// Fin ou coupure de la tranche du CPU c à la date now
+static int stop(Smp *m, int c, long long now) {
+    Engine *e = m->e;
+    Cpu *cpu = &m->cpu[c];
+    int i = cpu->current;
+    long long ran = now > cpu->since ? now - cpu->since : 0;   // coupé pendant la commutation : 0
+
+    if(ran > 0 && !schedule_add(&e->stats.cpu_sched[c], i, cpu->since, now, cpu->level))
+        return 0;
+    e->p[i].remaining -= (int)switch_out(e, c, i, ran);
+    e->stats.busy[c] += ran;
+    if(e->p[i].remaining == 0 && !io_block(e, i, now)) {
+        e->finish[i] = now;
+        m->done++;
+    }
+
+    cpu->current = -1;
+    m->load[c]--;
+    heap_remove(&m->running, c);
+    e->rq = cpu->rq;
+    e->level = cpu->level;
+    if(m->cls->put_prev) {
+        m->cls->put_prev(e, i, ran);
+        PROF_COUNT(e, queue_ops);
+    }
+    // Toutes les politiques remettent i dans la file s'il lui reste du travail (bloqué : non)
+    if(e->p[i].remaining > 0) {
+        m->queued[c]++;
+        m->load[c]++;
+    }
+    return 1;
+}
+
+// Équilibrage à l'inactivité (newidle balance) : la file la plus chargée cède un processus
+static int steal_for(Smp *m, int c) {
+    Engine *e = m->e;
+    // La file de c est vide : le maximum, s'il est non nul, est ailleurs
+    int victim = vec_argmax_int(m->queued, m->ncpu);
+    if(victim < 0 || victim == c || m->queued[victim] == 0) return -1;
+
+    e->rq = m->cpu[victim].rq;
+    e->level = 0;
+    int i = m->cls->steal ? m->cls->steal(e) : m->cls->pick_next(e);
+    PROF_COUNT(e, queue_ops);
+    if(i < 0) return -1;
+    m->queued[victim]--;
+    m->load[victim]--;
+    e->stats.steals++;
+
+    // Passage par la file locale (vide) pour que la politique y tienne son état
+    e->rq = m->cpu[c].rq;
+    m->cls->enqueue(e, i);
+    e->level = 0;
+    PROF_ADD(e, queue_ops, 2);
+    return m->cls->pick_next(e);
+}
+
+static void dispatch(Smp *m, int c, long long now) {
+    Engine *e = m->e;
+    Cpu *cpu = &m->cpu[c];
+
+    e->rq = cpu->rq;
+    e->level = 0;
+    int i = m->cls->pick_next(e);
+    PROF_COUNT(e, queue_ops);
+    if(i >= 0) {
+        if(!m->global) {
+            m->queued[c]--;
+            m->load[c]--;
+        }
+    } else if(e->smp.steal && !m->global) {
+        i = steal_for(m, c);
+    }
+    if(i < 0) return;
+    PROF_COUNT(e, decisions);
+
+    // La tranche commence après la commutation, le CPU étant occupé entre-temps
+    now += switch_in(e, c, i);
+    long long end = now + m->cls->slice(e, i) + switch_warmup(e, i);
+    engine_dispatch(e, i, now);
+    if(m->last_cpu[i] >= 0 && m->last_cpu[i] != c) {
+        e->stats.migrations[c]++;
+        e->stats.total_migrations++;
+    }
+    m->last_cpu[i] = c;
+    cpu->current = i;
+    m->load[c]++;
+    cpu->since = now;
+    cpu->level = e->level;
+    heap_push(&m->running, c, end);
+}
+
+static int smp_init(Smp *m, Engine *e, const SchedClass *cls, int quantum) {
+    Arena *a = e->arena;
+    int ncpu = e->smp.ncpu;
+
+    m->e = e;
+    m->cls = cls;
+    m->ncpu = ncpu;
+    m->global = e->smp.global_queue;
+    m->done = e->first;
+    m->cpu = arena_calloc(a, ncpu, sizeof(Cpu));
+    m->queued = arena_calloc(a, ncpu, sizeof(int));
+    m->load = arena_calloc(a, ncpu, sizeof(int));
+    m->last_cpu = arena_alloc(a, sizeof(int) * (e->n > 0 ? e->n : 1));
+    e->stats.cpu_sched = arena_calloc(a, ncpu, sizeof(Schedule));
+    e->stats.busy = arena_calloc(a, ncpu, sizeof(long long));
+    e->stats.migrations = arena_calloc(a, ncpu, sizeof(long long));
+    if(!m->cpu || !m->queued || !m->load || !m->last_cpu || !e->stats.cpu_sched || !e->stats.busy || !e->stats.migrations)
+        return 0;
+    if(!heap_init(&m->running, ncpu, a)) return 0;
+
+    for(int i = 0; i < e->n; i++) m->last_cpu[i] = -1;
+    for(int c = 0; c < ncpu; c++) {
+        m->cpu[c].current = -1;
+        m->cpu[c].rq = m->global && c > 0 ? m->cpu[0].rq : cls->create(e, quantum);
+        if(!m->cpu[c].rq || !schedule_init(&e->stats.cpu_sched[c], a, e->n / ncpu + 16))
+            return 0;
+        e->stats.cpu_sched[c].cpu = c;
+    }
+    return 1;
+}
+
+int smp_run(Engine *e, const SchedClass *cls, int quantum) {
+    Smp m;
+    int next = e->first, i;
+    long long now = e->time;
+
+    if(!smp_init(&m, e, cls, quantum)) return 0;
+
+    while(m.done < e->n) {
+        e->time = now;   // horloge commune, lue par les politiques à vieillissement
+        // Arrivées et réveils d'abord : ils passent avant le processus remis en file (comme engine_run)
+        int arrived = 0;
+        while((i = engine_next_ready(e, &next, now)) >= 0) {
+            int c = place(&m);
+            e->rq = m.cpu[c].rq;
+            cls->enqueue(e, i);
+            PROF_COUNT(e, queue_ops);
+            if(!m.global) {
+                m.queued[c]++;
+                m.load[c]++;
+            }
+            m.cpu[c].preempt = 1;
+            arrived = 1;
+        }
+
+        while(!heap_empty(&m.running) && m.running.key[heap_top(&m.running)] <= now)
+            if(!stop(&m, heap_top(&m.running), now)) return 0;
+
+        // Préemption : le CPU qui a reçu l'arrivée, ou tous en file globale
+        for(int c = 0; c < m.ncpu; c++) {
+            if(cls->preemptive && arrived && m.cpu[c].current >= 0 && (m.global || m.cpu[c].preempt)) {
+                if(!stop(&m, c, now)) return 0;
+                PROF_COUNT(e, preemptions);
+            }
+            m.cpu[c].preempt = 0;
+        }
+
+        for(int c = 0; c < m.ncpu; c++)
+            if(m.cpu[c].current < 0) dispatch(&m, c, now);
+        e->events++;
+
+        long long t = LLONG_MAX;
+        if(!heap_empty(&m.running)) t = m.running.key[heap_top(&m.running)];
+        long long event = engine_next_event(e, next);
+        if(event < t) t = event;
+        if(t == LLONG_MAX) break;
+        // Tous les CPU inactifs : le temps saute jusqu'à la prochaine arrivée ou fin d'E/S
+        if(heap_empty(&m.running)) {
+            PROF_COUNT(e, idle_skips);
+            PROF_ADD(e, idle_time, t - now);
+        }
+        now = t;
+    }
+
+    e->time = now;
+    e->horizon = now;
+    return schedule_merge(&e->sched, e->stats.cpu_sched, m.ncpu);
+}
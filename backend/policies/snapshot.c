@@ -0,0 +1,104 @@
+#include <string.h>
+#include "../include/engine.h"
+
+/*
+ * Image d'une exécution en pleine charge, pour la reprendre sans attendre que
+ * le CPU soit libre. Elle commence par le nombre et la liste des processus
+ * en cours ; suivent leur avancement, les E/S, les commutations et la file de
+ * la politique. Ce qui ne dépend que de la trace (processus à venir) n'y est
+ * pas : la reprise part d'un moteur neuf sur la nouvelle trace.
+ */
+void snap_bytes(Snapshot *s, void *p, size_t n) {
+    if(s->mode == SNAP_SAVE) memcpy(s->data + s->len, p, n);
+    else if(s->mode == SNAP_LOAD) memcpy(p, s->data + s->len, n);
+    s->len += n;
+}
+
+void snap_live(Snapshot *s, void *array, size_t stride, size_t size) {
+    if(s->mode == SNAP_SIZE) {
+        s->len += size * s->nlive;
+        return;
+    }
+    for(int k = 0; k < s->nlive; k++)
+        snap_bytes(s, (char *)array + (size_t)s->live[k] * stride, size);
+}
+
+// Le tableau du tas et la clé de chacun de ses éléments ; les positions s'en déduisent
+void snap_heap(Snapshot *s, MinHeap *h) {
+    SNAP(s, h->size);
+    snap_bytes(s, h->heap, sizeof(int) * h->size);
+    for(int k = 0; k < h->size; k++) {
+        SNAP(s, h->key[h->heap[k]]);
+        if(s->mode == SNAP_LOAD) h->pos[h->heap[k]] = k;
+    }
+}
+
+// La capacité dépend de la trace : la position de la tête n'est pas gardée
+void snap_ring(Snapshot *s, int *queue, int size, int *head, int *count) {
+    SNAP(s, *count);
+    if(s->mode == SNAP_LOAD) *head = 0;
+    for(int k = 0; k < *count; k++)
+        SNAP(s, queue[(*head + k) % size]);
+}
+
+static void engine_image(Engine *e, Snapshot *s) {
+    snap_live(s, &e->p->remaining, sizeof(Process), sizeof(int));
+    SNAP_LIVE(s, e->start);
+    if(e->io) {
+        IoState *io = e->io;
+        int ndev = io->ndev;
+        // Les périphériques après le dernier occupé sont libres : la nouvelle trace peut en avoir moins
+        if(s->mode != SNAP_LOAD)
+            while(ndev > 0 && io->dev[ndev - 1].current < 0 && io->dev[ndev - 1].head < 0) ndev--;
+        SNAP(s, ndev);
+        snap_bytes(s, io->dev, sizeof(IoDevice) * ndev);
+        snap_heap(s, &io->wake);
+        SNAP_LIVE(s, io->phase);
+        SNAP_LIVE(s, io->next);
+        SNAP_LIVE(s, io->blocked);
+        SNAP_LIVE(s, io->since);
+        SNAP_LIVE(s, io->ready);
+        SNAP_LIVE(s, io->response);
+    }
+    if(e->sw) {
+        SwitchState *sw = e->sw;
+        SNAP(s, sw->last[0]);
+        SNAP(s, sw->clock[0]);
+        SNAP_LIVE(s, sw->cpu);
+        SNAP_LIVE(s, sw->mark);
+        SNAP_LIVE(s, sw->warm);
+    }
+    e->cls->snapshot(e, s);
+}
+
+size_t engine_image_size(Engine *e, int nlive) {
+    Snapshot s = { SNAP_SIZE, NULL, sizeof(int) * (1 + nlive), NULL, nlive };
+    engine_image(e, &s);
+    return s.len;
+}
+
+int engine_snapshot(Engine *e, int oldest, int next, int done, Checkpoint *c) {
+    int nlive = next - done;
+    int *live = arena_alloc(e->arena, c->image_len);
+    if(!live) return 0;
+    live[0] = nlive;
+    for(int j = oldest, k = 1; j < next; j++)
+        if(e->finish[e->order[j]] < 0) live[k++] = e->order[j];
+
+    Snapshot s = { SNAP_SAVE, (unsigned char *)live, sizeof(int) * (1 + nlive), live + 1, nlive };
+    c->image = s.data;
+    engine_image(e, &s);
+    return 1;
+}
+
+// Appelée par engine_run, la file de la politique une fois créée
+void engine_restore(Engine *e) {
+    const int *live = (const int *)e->image;
+    Snapshot s = { SNAP_LOAD, (unsigned char *)e->image, sizeof(int) * (1 + live[0]), live + 1, live[0] };
+
+    // Le processus a fini plus tard dans l'exécution d'origine
+    for(int k = 0; k < s.nlive; k++)
+        e->finish[s.live[k]] = -1;
+    engine_image(e, &s);
+    e->image = NULL;
+}
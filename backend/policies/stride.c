@@ -0,0 +1,125 @@
+#include "../include/process.h"
+#include "../include/engine.h"
+#include "../include/heap.h"
+#include "../include/nice.h"
+
+/*
+ * Stride : la version déterministe de la loterie. Chaque processus a un pas
+ * inversement proportionnel à son poids et avance d'autant par unité
+ * exécutée ; le plus petit passage tourne. L'écart à la part idéale reste
+ * borné par un quantum, au lieu de croître comme la racine du nombre de
+ * tirages. Le reste de la division par le poids est reporté : le passage
+ * vaut exactement service * STRIDE1 / poids, sans dérive d'arrondi.
+ */
+#define STRIDE1 (1 << 20)   // pas d'un poids NICE_0_WEIGHT : 1024
+
+// État par processus, commun à toutes les files (SMP)
+typedef struct {
+    long long *pass;         // relatif à la file tant qu'il est hors file (vol, E/S)
+    int *rem;                // reste de service * STRIDE1 / poids, < poids
+    unsigned char *placed;   // déjà entré dans une file
+} StrideShared;
+
+typedef struct {
+    MinHeap ready;           // par passage, puis admission
+    long long vtime;         // passage du dernier élu, ne fait que croître
+    int quantum;
+    StrideShared *sh;
+} StrideQueue;
+
+// Avance le passage de i de units unités de service
+static void advance(const Engine *e, StrideShared *sh, int i, long long units) {
+    int weight = nice_weight(e->p[i].priority);
+    long long step = units * STRIDE1 + sh->rem[i];
+    sh->pass[i] += step / weight;
+    sh->rem[i] = (int)(step % weight);
+}
+
+// Nouveau venu : un quantum de pas après le dernier élu, comme un client qui rejoint
+static void stride_enqueue(Engine *e, int i) {
+    StrideQueue *q = e->rq;
+    StrideShared *sh = q->sh;
+
+    if(!sh->placed[i]) {
+        advance(e, sh, i, q->quantum);
+        sh->placed[i] = 1;
+    }
+    sh->pass[i] += q->vtime;
+    heap_push(&q->ready, i, sh->pass[i]);
+}
+
+static int stride_pick_next(Engine *e) {
+    StrideQueue *q = e->rq;
+    int i = heap_pop(&q->ready);
+    if(i >= 0) q->vtime = q->sh->pass[i];
+    return i;
+}
+
+static long long stride_slice(Engine *e, int i) {
+    StrideQueue *q = e->rq;
+    return e->p[i].remaining > q->quantum ? q->quantum : e->p[i].remaining;
+}
+
+static void stride_put_prev(Engine *e, int i, long long ran) {
+    StrideQueue *q = e->rq;
+    StrideShared *sh = q->sh;
+
+    advance(e, sh, i, ran);
+    if(e->p[i].remaining > 0)
+        heap_push(&q->ready, i, sh->pass[i]);
+    else
+        sh->pass[i] -= q->vtime;   // bloqué en E/S : stride_enqueue le recale au réveil
+}
+
+// Migration : le passage est rendu relatif à la file d'origine
+static int stride_steal(Engine *e) {
+    StrideQueue *q = e->rq;
+    int i = heap_pop(&q->ready);
+    if(i >= 0) q->sh->pass[i] -= q->vtime;
+    return i;
+}
+
+static void *stride_create(Engine *e, int quantum) {
+    Arena *a = e->arena;
+    StrideQueue *q = arena_alloc(a, sizeof(StrideQueue));
+    if(!q || !heap_init(&q->ready, e->n, a)) return NULL;
+    q->ready.rank = e->seq;
+
+    if(!e->policy_data) {
+        StrideShared *sh = arena_alloc(a, sizeof(StrideShared));
+        if(!sh) return NULL;
+        sh->pass = arena_calloc(a, e->n, sizeof(long long));
+        sh->rem = arena_calloc(a, e->n, sizeof(int));
+        sh->placed = arena_calloc(a, e->n, 1);
+        if(!sh->pass || !sh->rem || !sh->placed) return NULL;
+        e->policy_data = sh;
+    }
+    q->sh = e->policy_data;
+    q->vtime = 0;
+    q->quantum = quantum;
+    return q;
+}
+
+static void stride_reset(Engine *e, int i) {
+    StrideShared *sh = e->policy_data;
+    sh->pass[i] = 0;
+    sh->rem[i] = 0;
+    sh->placed[i] = 0;
+}
+
+static void stride_snapshot(Engine *e, Snapshot *s) {
+    StrideQueue *q = e->rq;
+    StrideShared *sh = q->sh;
+
+    snap_heap(s, &q->ready);
+    SNAP(s, q->vtime);
+    SNAP_LIVE(s, sh->pass);
+    SNAP_LIVE(s, sh->rem);
+    SNAP_LIVE(s, sh->placed);
+}
+
+static const SchedClass stride_class = { 0, stride_create, stride_enqueue, stride_pick_next, stride_slice, stride_put_prev, stride_steal, stride_reset, stride_snapshot };
+
+int stride(Engine *e, int quantum) {
+    return engine_simulate(e, &stride_class, quantum);
+}
@@ -0,0 +1,68 @@
+#include "../include/engine.h"
+
+/*
+ * Coût des changements de contexte. Charger sur un CPU un autre processus
+ * que le dernier qu'il a exécuté coûte cost unités pendant lesquelles rien
+ * n'avance. Le processus repart ensuite avec un cache en partie froid : il
+ * lui faut d'abord recharger autant que ce qui a tourné sur ce CPU depuis
+ * son départ, au plus warmup (warmup entier s'il change de CPU ou n'a jamais
+ * tourné). Ce réchauffement s'ajoute à la tranche accordée par la politique :
+ * le processus occupe le CPU sans avancer, mais chaque tranche le fait
+ * progresser, même quand le quantum est plus court que le réchauffement.
+ */
+int switch_init(Engine *e) {
+    e->sw = NULL;
+    if(e->cost.cost == 0 && e->cost.warmup == 0) return 1;
+
+    Arena *a = e->arena;
+    int ncpu = e->smp.ncpu, n = e->n > 0 ? e->n : 1;
+    SwitchState *sw = arena_alloc(a, sizeof(SwitchState));
+    if(!sw) return 0;
+    sw->last = arena_alloc(a, sizeof(int) * ncpu);
+    sw->clock = arena_calloc(a, ncpu, sizeof(long long));
+    sw->cpu = arena_alloc(a, sizeof(int) * n);
+    sw->mark = arena_calloc(a, n, sizeof(long long));
+    sw->warm = arena_calloc(a, n, sizeof(long long));
+    if(!sw->last || !sw->clock || !sw->cpu || !sw->mark || !sw->warm) return 0;
+    for(int c = 0; c < ncpu; c++) sw->last[c] = -1;
+    for(int i = 0; i < e->n; i++) sw->cpu[i] = -1;
+    e->sw = sw;
+    return 1;
+}
+
+long long switch_in(Engine *e, int c, int i) {
+    SwitchState *sw = e->sw;
+    if(!sw || sw->last[c] == i) return 0;
+
+    long long warm = e->cost.warmup;
+    if(sw->cpu[i] == c && sw->clock[c] - sw->mark[i] < warm) warm = sw->clock[c] - sw->mark[i];
+    // Un réchauffement interrompu reste dû, sans s'additionner au nouveau
+    if(warm > sw->warm[i]) sw->warm[i] = warm;
+    sw->last[c] = i;
+    e->overhead.switches++;
+    e->overhead.switch_time += e->cost.cost;
+    return e->cost.cost;
+}
+
+long long switch_out(Engine *e, int c, int i, long long ran) {
+    SwitchState *sw = e->sw;
+    if(!sw) return ran;
+
+    long long paid = ran < sw->warm[i] ? ran : sw->warm[i];
+    sw->warm[i] -= paid;
+    e->overhead.warmup_time += paid;
+    sw->clock[c] += ran;
+    sw->mark[i] = sw->clock[c];
+    sw->cpu[i] = c;
+    return ran - paid;
+}
+
+// Case réutilisée (flux) : le nouveau processus n'a jamais tourné
+void switch_reset(Engine *e, int i) {
+    SwitchState *sw = e->sw;
+    if(!sw) return;
+    for(int c = 0; c < e->smp.ncpu; c++)
+        if(sw->last[c] == i) sw->last[c] = -1;
+    sw->cpu[i] = -1;
+    sw->mark[i] = sw->warm[i] = 0;
+}
@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../include/arena.h"
+
+#define ARENA_ALIGN 16
+
+static ArenaChunk *chunk_new(ArenaChunk *prev, size_t size) {
+    ArenaChunk *c = malloc(sizeof(ArenaChunk) + size);
+    if(!c) return NULL;
+    c->prev = prev;
+    c->size = size;
+    c->used = 0;
+    return c;
+}
+
+int arena_init(Arena *a, size_t size) {
+    a->head = chunk_new(NULL, size > 0 ? size : 4096);
+    return a->head != NULL;
+}
+
+void *arena_alloc(Arena *a, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if(size == 0) size = ARENA_ALIGN;
+
+    ArenaChunk *c = a->head;
+    if(!c || c->size - c->used < size) {
+        // Bloc plein : on en chaîne un nouveau, au moins deux fois plus grand
+        size_t next = c ? c->size * 2 : 4096;
+        if(next < size) next = size;
+        c = chunk_new(a->head, next);
+        if(!c) return NULL;
+        a->head = c;
+    }
+
+    void *ptr = c->data + c->used;
+    c->used += size;
+    return ptr;
+}
+
+void *arena_calloc(Arena *a, size_t count, size_t size) {
+    void *ptr = arena_alloc(a, count * size);
+    if(ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+ArenaMark arena_mark(Arena *a) {
+    ArenaMark m = { a->head, a->head ? a->head->used : 0 };
+    return m;
+}
+
+void arena_reset(Arena *a, ArenaMark m) {
+    while(a->head && a->head != m.chunk) {
+        ArenaChunk *prev = a->head->prev;
+        free(a->head);
+        a->head = prev;
+    }
+    if(a->head) a->head->used = m.used;
+}
+
+void arena_free(Arena *a) {
+    while(a->head) {
+        ArenaChunk *prev = a->head->prev;
+        free(a->head);
+        a->head = prev;
+    }
+}
@@ -0,0 +1,76 @@
+#include "../include/bitmap.h"
+
+static int lowest(uint64_t w) {
+    return __builtin_ctzll(w);
+}
+
+static int highest(uint64_t w) {
+    return 63 - __builtin_clzll(w);
+}
+
+int bitmap_init(Bitmap *b, int bits, Arena *a) {
+    int n = bits > 0 ? bits : 1;
+
+    b->depth = 0;
+    do {
+        if(b->depth == BITMAP_MAX_DEPTH) return 0;
+        n = (n + 63) / 64;
+        b->word[b->depth] = arena_calloc(a, n, sizeof(uint64_t));
+        if(!b->word[b->depth]) return 0;
+        b->words[b->depth++] = n;
+    } while(n > 1);
+    return 1;
+}
+
+void bitmap_set(Bitmap *b, int i) {
+    for(int k = 0; k < b->depth; k++) {
+        uint64_t *w = &b->word[k][i >> 6];
+        int was_empty = *w == 0;
+        *w |= (uint64_t)1 << (i & 63);
+        if(!was_empty) return;
+        i >>= 6;
+    }
+}
+
+void bitmap_clear(Bitmap *b, int i) {
+    for(int k = 0; k < b->depth; k++) {
+        uint64_t *w = &b->word[k][i >> 6];
+        *w &= ~((uint64_t)1 << (i & 63));
+        if(*w != 0) return;
+        i >>= 6;
+    }
+}
+
+int bitmap_first(const Bitmap *b) {
+    int i = 0;
+    if(b->word[b->depth - 1][0] == 0) return -1;
+    for(int k = b->depth - 1; k >= 0; k--)
+        i = (i << 6) + lowest(b->word[k][i]);
+    return i;
+}
+
+int bitmap_last(const Bitmap *b) {
+    int i = 0;
+    if(b->word[b->depth - 1][0] == 0) return -1;
+    for(int k = b->depth - 1; k >= 0; k--)
+        i = (i << 6) + highest(b->word[k][i]);
+    return i;
+}
+
+// On remonte tant que le mot courant n'a plus de bit à droite de la position, puis on redescend
+int bitmap_next(const Bitmap *b, int from) {
+    int i = from;
+    for(int k = 0; k < b->depth; k++) {
+        int w = i >> 6;
+        if(w >= b->words[k]) return -1;
+        uint64_t rest = b->word[k][w] & (~(uint64_t)0 << (i & 63));
+        if(rest) {
+            i = (w << 6) + lowest(rest);
+            while(--k >= 0)
+                i = (i << 6) + lowest(b->word[k][i]);
+            return i;
+        }
+        i = w + 1;
+    }
+    return -1;
+}
@@ -0,0 +1,37 @@
+#include "../include/fenwick.h"
+
+int fenwick_init(Fenwick *f, int n, Arena *a) {
+    if(n < 1) n = 1;
+    f->tree = arena_calloc(a, n + 1, sizeof(long long));
+    f->n = n;
+    f->total = 0;
+    for(f->top = 1; f->top * 2 <= n; f->top *= 2);
+    return f->tree != NULL;
+}
+
+void fenwick_add(Fenwick *f, int i, long long delta) {
+    f->total += delta;
+    for(int k = i + 1; k <= f->n; k += k & -k)
+        f->tree[k] += delta;
+}
+
+// tree[i + 1] moins les intervalles qui couvrent ]i + 1 - lowbit, i]
+long long fenwick_weight(const Fenwick *f, int i) {
+    int k = i + 1, stop = k - (k & -k);
+    long long w = f->tree[k];
+    for(int j = k - 1; j > stop; j -= j & -j)
+        w -= f->tree[j];
+    return w;
+}
+
+// Descente depuis la plus grande puissance de 2 : on garde le plus long préfixe de somme <= r
+int fenwick_find(const Fenwick *f, long long r) {
+    int pos = 0;
+    for(int step = f->top; step > 0; step >>= 1) {
+        if(pos + step <= f->n && f->tree[pos + step] <= r) {
+            pos += step;
+            r -= f->tree[pos];
+        }
+    }
+    return pos;   // préfixe de pos éléments <= r : l'élément d'indice pos le dépasse
+}
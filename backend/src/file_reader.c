@@ -1,30 +1,258 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "../include/process.h"
+#include "../include/trace_reader.h"
+#include "../include/trace_format.h"
+#include "../include/profile.h"
 
-int lire_fichier_processus(char *filename, Process p[], int *n) {
-    FILE *f = fopen(filename, "r");
-    if (!f) {
-        printf("Erreur : impossible d'ouvrir %s\n", filename);
+#define READ_CHUNK (1 << 20)
+
+int trace_open(TraceReader *r, const char *filename) {
+    memset(r, 0, sizeof(*r));
+    r->filename = filename;
+    r->f = strcmp(filename, "-") == 0 ? stdin : fopen(filename, "r");
+    if (!r->f) return 0;
+
+    r->cap = READ_CHUNK;
+    r->buf = malloc(r->cap);
+    if (!r->buf) {
+        trace_close(r);
+        return 0;
+    }
+    return 1;
+}
+
+void trace_close(TraceReader *r) {
+    if (r->f && r->f != stdin) fclose(r->f);
+    free(r->buf);
+    r->f = NULL;
+    r->buf = NULL;
+}
+
+// Garde la ligne entamée en tête du tampon et complète avec la suite du fichier
+static int refill(TraceReader *r) {
+    if (r->eof) return 0;
+
+    if (r->pos > 0) {
+        memmove(r->buf, r->buf + r->pos, r->len - r->pos);
+        r->len -= r->pos;
+        r->pos = 0;
+    }
+    if (r->len == r->cap) {
+        char *bigger = realloc(r->buf, r->cap * 2);
+        if (!bigger) return 0;
+        r->buf = bigger;
+        r->cap *= 2;
+    }
+
+    // read() rend ce qui est disponible : indispensable sur un tube interactif
+    ssize_t got = read(fileno(r->f), r->buf + r->len, r->cap - r->len);
+    if (got <= 0) {
+        r->eof = 1;
+        return 0;
+    }
+    r->len += got;
+    return 1;
+}
+
+static const char *skip_blank(const char *s, const char *end) {
+    while (s < end && (*s == ' ' || *s == '\t' || *s == '\r')) s++;
+    return s;
+}
+
+static int parse_int(const char **s, const char *end, int *out) {
+    const char *c = skip_blank(*s, end);
+    int neg = 0;
+    long long v = 0;
+
+    if (c < end && (*c == '-' || *c == '+')) neg = (*c++ == '-');
+    if (c >= end || *c < '0' || *c > '9') return 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        v = v * 10 + (*c++ - '0');
+        if (v > 2147483647LL) return 0;
+    }
+    if (c < end && *c != ' ' && *c != '\t' && *c != '\r') return 0;
+
+    *out = neg ? (int)-v : (int)v;
+    *s = c;
+    return 1;
+}
+
+// Durée d'E/S, suivie de "@périphérique" si ce n'est pas le périphérique 0
+static int parse_io(const char **s, const char *end, int *length, int *device) {
+    const char *c = skip_blank(*s, end);
+    long long v = 0;
+
+    if (c >= end || *c < '0' || *c > '9') return 0;
+    while (c < end && *c >= '0' && *c <= '9') {
+        v = v * 10 + (*c++ - '0');
+        if (v > 2147483647LL) return 0;
+    }
+    *length = (int)v;
+    *device = 0;
+    if (c < end && *c == '@') {
+        c++;
+        if (c >= end || *c < '0' || *c > '9') return 0;
+        *s = c;
+        return parse_int(s, end, device);
+    }
+    if (c < end && *c != ' ' && *c != '\t' && *c != '\r') return 0;
+    *s = c;
+    return 1;
+}
+
+// Compte les champs restants de la ligne
+static int count_fields(const char *s, const char *end) {
+    int n = 0;
+    for (;;) {
+        s = skip_blank(s, end);
+        if (s == end) return n;
+        n++;
+        while (s < end && *s != ' ' && *s != '\t' && *s != '\r') s++;
+    }
+}
+
+static void malformed(TraceReader *r, const char *why) {
+    fprintf(stderr, "%s:%d : ligne ignorée (%s)\n", r->filename, r->line, why);
+    r->errors++;
+}
+
+int trace_read_line(TraceReader *r, const char **line, const char **end) {
+    for (;;) {
+        char *nl = memchr(r->buf + r->pos, '\n', r->len - r->pos);
+        if (!nl) {
+            if (refill(r)) continue;
+            if (r->pos >= r->len) return 0;
+            nl = r->buf + r->len;   // dernière ligne sans retour à la ligne
+        }
+
+        *line = r->buf + r->pos;
+        *end = nl;
+        r->pos = (nl - r->buf) + (nl < r->buf + r->len ? 1 : 0);
+        r->line++;
+        return 1;
+    }
+}
+
+int trace_parse_process(TraceReader *r, const char *s, const char *end, StringPool *names, Process *out) {
+    s = skip_blank(s, end);
+    if (s == end || *s == '#') return 0;
+
+    const char *name = s;
+    while (s < end && *s != ' ' && *s != '\t' && *s != '\r') s++;
+    size_t name_len = s - name;
+
+    int a, b, pr;
+    if (!parse_int(&s, end, &a) || !parse_int(&s, end, &b) || !parse_int(&s, end, &pr)) {
+        malformed(r, "attendu : nom arrivée burst priorité");
+        return -1;
+    }
+    if (a < 0 || b < 0) {
+        malformed(r, "arrivée et burst doivent être positifs");
+        return -1;
+    }
+
+    // Suite facultative de couples "E/S rafale" : l'E/S en durée[@périphérique]
+    int fields = count_fields(s, end);
+    if (fields % 2 != 0) {
+        malformed(r, "une E/S doit être suivie d'une rafale CPU");
+        return -1;
+    }
+    IoBurst *io = NULL;
+    long long total = b;
+    if (fields > 0) {
+        // Dans l'arène des noms, c'est-à-dire celle de la table
+        io = arena_alloc(names->arena, sizeof(IoBurst) * (fields / 2));
+        if (!io) return -1;
+        for (int k = 0; k < fields / 2; k++) {
+            if (!parse_io(&s, end, &io[k].length, &io[k].device) || !parse_int(&s, end, &io[k].cpu)) {
+                malformed(r, "attendu : durée[@périphérique] rafale");
+                return -1;
+            }
+            if (io[k].length <= 0 || io[k].cpu <= 0 || io[k].device >= MAX_DEVICES) {
+                malformed(r, "E/S et rafales doivent être strictement positives, périphérique < 256");
+                return -1;
+            }
+            total += io[k].cpu;
+        }
+        if (total > 2147483647LL) {
+            malformed(r, "temps CPU total trop grand");
+            return -1;
+        }
+    }
+
+    out->name = pool_intern(names, name, name_len);
+    if (!out->name) return -1;
+    out->arrival = a;
+    out->burst = (int)total;
+    out->priority = pr;
+    out->remaining = b;
+    out->nio = fields / 2;
+    out->io = io;
+    return 1;
+}
+
+int trace_next(TraceReader *r, StringPool *names, Process *out) {
+    const char *line, *end;
+    while (trace_read_line(r, &line, &end))
+        if (trace_parse_process(r, line, end, names, out) == 1)
+            return 1;
+    return 0;
+}
+
+static int charger(char *filename, ProcessTable *t) {
+    if (strcmp(filename, "-") != 0 && trace_is_binary(filename))
+        return charger_trace_binaire(filename, t);
+
+    TraceReader r;
+    if (!trace_open(&r, filename)) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir %s\n", filename);
         return 0; 
     }
 
-    *n = 0;
-    while (!feof(f)) {
-        int a, b, pr;
-        char nom[20];
+    // Estimation de la taille de la table à partir de la taille du fichier
+    struct stat st;
+    int estimate = 1024;
+    if (r.f != stdin && fstat(fileno(r.f), &st) == 0 && st.st_size / 12 < 100000000)
+        estimate = (int)(st.st_size / 12) + 16;
+
+    if (!table_init(t, estimate)) {
+        fprintf(stderr, "Erreur : mémoire insuffisante pour %d processus\n", estimate);
+        trace_close(&r);
+        return 0;
+    }
 
-        if (fscanf(f, "%s %d %d %d", nom, &a, &b, &pr) == 4) {
-            p[*n].id = *n + 1;
-            strcpy(p[*n].name, nom);
-            p[*n].arrival = a;
-            p[*n].burst = b;
-            p[*n].priority = pr;
-            p[*n].remaining = b;
-            (*n)++;
+    Process proc;
+    while (trace_next(&r, &t->names, &proc)) {
+        Process *slot = table_push(t);
+        if (!slot) {
+            fprintf(stderr, "Erreur : mémoire insuffisante\n");
+            trace_close(&r);
+            table_free(t);
+            return 0;
         }
+        proc.id = slot->id;
+        *slot = proc;
     }
 
-    fclose(f);
+    if (r.errors > 0)
+        fprintf(stderr, "%s : %d ligne(s) invalide(s) ignorée(s)\n", filename, r.errors);
+
+    trace_close(&r);
     return 1;
 }
+
+int lire_fichier_processus(char *filename, ProcessTable *t) {
+#ifdef PROFILE
+    double t0 = prof_now();
+    int ok = charger(filename, t);
+    if (ok) t->load_time = prof_now() - t0;
+    return ok;
+#else
+    return charger(filename, t);
+#endif
+}
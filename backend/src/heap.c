@@ -0,0 +1,84 @@
+#include "../include/heap.h"
+
+static int heap_less(const MinHeap *h, int a, int b) {
+    if(h->key[a] != h->key[b]) return h->key[a] < h->key[b];
+    if(h->rank) return h->rank[a] < h->rank[b];
+    return a < b;
+}
+
+static void heap_swap(MinHeap *h, int x, int y) {
+    int a = h->heap[x], b = h->heap[y];
+    h->heap[x] = b;
+    h->heap[y] = a;
+    h->pos[b] = x;
+    h->pos[a] = y;
+}
+
+static void sift_up(MinHeap *h, int k) {
+    while(k > 0) {
+        int parent = (k - 1) / 2;
+        if(!heap_less(h, h->heap[k], h->heap[parent])) break;
+        heap_swap(h, k, parent);
+        k = parent;
+    }
+}
+
+static void sift_down(MinHeap *h, int k) {
+    for(;;) {
+        int l = 2 * k + 1, r = l + 1, m = k;
+        if(l < h->size && heap_less(h, h->heap[l], h->heap[m])) m = l;
+        if(r < h->size && heap_less(h, h->heap[r], h->heap[m])) m = r;
+        if(m == k) break;
+        heap_swap(h, k, m);
+        k = m;
+    }
+}
+
+int heap_init(MinHeap *h, int cap, Arena *a) {
+    if(cap < 1) cap = 1;
+    h->heap = arena_alloc(a, sizeof(int) * cap);
+    h->pos = arena_alloc(a, sizeof(int) * cap);
+    h->key = arena_alloc(a, sizeof(long long) * cap);
+    h->rank = NULL;
+    h->size = 0;
+    h->cap = cap;
+    if(!h->heap || !h->pos || !h->key) return 0;
+    for(int i = 0; i < cap; i++) h->pos[i] = -1;
+    return 1;
+}
+
+void heap_push(MinHeap *h, int i, long long key) {
+    if(h->pos[i] >= 0) {
+        heap_update(h, i, key);
+        return;
+    }
+    h->key[i] = key;
+    h->heap[h->size] = i;
+    h->pos[i] = h->size;
+    sift_up(h, h->size++);
+}
+
+void heap_update(MinHeap *h, int i, long long key) {
+    long long old = h->key[i];
+    h->key[i] = key;
+    if(key < old) sift_up(h, h->pos[i]);
+    else sift_down(h, h->pos[i]);
+}
+
+int heap_pop(MinHeap *h) {
+    if(h->size == 0) return -1;
+    int top = h->heap[0];
+    heap_remove(h, top);
+    return top;
+}
+
+void heap_remove(MinHeap *h, int i) {
+    int k = h->pos[i];
+    if(k < 0) return;
+    heap_swap(h, k, --h->size);
+    h->pos[i] = -1;
+    if(k < h->size) {
+        sift_down(h, k);
+        sift_up(h, k);
+    }
+}
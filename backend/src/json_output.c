@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include "../include/render.h"
+#include "../include/metrics.h"
+#include "../include/writer.h"
+
+void w_json_string(Writer *w, const char *s) {
+    w_putc(w, '"');
+    for(; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if(c == '"' || c == '\\') {
+            w_putc(w, '\\');
+            w_putc(w, (char)c);
+        }
+        else if(c < 0x20) w_printf(w, "\\u%04x", c);
+        else w_putc(w, (char)c);
+    }
+    w_putc(w, '"');
+}
+
+void json_print_string(FILE *out, const char *s) {
+    Writer w;
+    writer_init(&w, out);
+    w_json_string(&w, s);
+    w_flush(&w);
+}
+
+static void w_json_header(Writer *w, const Policy *pol, const Engine *e, int quantum) {
+    w_puts(w, "{\"id\":");
+    w_int(w, pol->id, 0);
+    w_puts(w, ",\"name\":");
+    w_json_string(w, pol->name);
+    if(pol->uses_quantum) w_printf(w, ",\"quantum\":%d", quantum);
+    w_printf(w, ",\"makespan\":%lld,\"events\":%lld", e->time, e->events);
+    if(e->smp.ncpu > 1) {
+        w_printf(w, ",\"cpus\":%d,\"global_queue\":%s,\"migrations\":%lld,\"steals\":%lld,\"cpu_busy\":[",
+                 e->smp.ncpu, e->smp.global_queue ? "true" : "false", e->stats.total_migrations, e->stats.steals);
+        for(int c = 0; c < e->smp.ncpu; c++) {
+            if(c > 0) w_putc(w, ',');
+            w_int(w, e->stats.busy[c], 0);
+        }
+        w_putc(w, ']');
+    }
+    if(e->sw)
+        w_printf(w, ",\"overhead\":{\"switch_cost\":%d,\"warmup\":%d,\"switches\":%lld,\"switch_time\":%lld,"
+                 "\"warmup_time\":%lld}", e->cost.cost, e->cost.warmup, e->overhead.switches,
+                 e->overhead.switch_time, e->overhead.warmup_time);
+}
+
+void render_json(FILE *out, const Policy *pol, const Engine *e, int quantum) {
+    const Process *p = e->p;
+    const Schedule *s = &e->sched;
+    Writer w;
+    Metrics m;
+
+    writer_init(&w, out);
+    w_json_header(&w, pol, e, quantum);
+
+    w_puts(&w, ",\"segments\":[");
+    for(int k = 0; k < s->count; k++) {
+        const Segment *seg = &s->seg[k];
+        if(k > 0) w_putc(&w, ',');
+        w_puts(&w, "{\"pid\":");
+        w_int(&w, p[seg->proc].id, 0);
+        w_puts(&w, ",\"process\":");
+        w_json_string(&w, p[seg->proc].name);
+        w_puts(&w, ",\"start\":");
+        w_int(&w, seg->start, 0);
+        w_puts(&w, ",\"end\":");
+        w_int(&w, seg->end, 0);
+        w_puts(&w, ",\"level\":");
+        w_int(&w, seg->level, 0);
+        if(e->smp.ncpu > 1) {
+            w_puts(&w, ",\"cpu\":");
+            w_int(&w, seg->cpu, 0);
+        }
+        w_putc(&w, '}');
+    }
+
+    w_puts(&w, "],\"processes\":[");
+    for(int i = 0; i < e->n; i++) {
+        long long turnaround = e->finish[i] - p[i].arrival;
+        long long response = e->start[i] >= 0 ? e->start[i] - p[i].arrival : 0;
+
+        if(i > 0) w_putc(&w, ',');
+        w_puts(&w, "{\"pid\":");
+        w_int(&w, p[i].id, 0);
+        w_puts(&w, ",\"name\":");
+        w_json_string(&w, p[i].name);
+        w_puts(&w, ",\"arrival\":");
+        w_int(&w, p[i].arrival, 0);
+        w_puts(&w, ",\"burst\":");
+        w_int(&w, p[i].burst, 0);
+        w_puts(&w, ",\"priority\":");
+        w_int(&w, p[i].priority, 0);
+        w_puts(&w, ",\"finish\":");
+        w_int(&w, e->finish[i], 0);
+        w_puts(&w, ",\"waiting\":");
+        w_int(&w, turnaround - p[i].burst - engine_blocked(e, i), 0);
+        if(e->io) {
+            w_puts(&w, ",\"blocked\":");
+            w_int(&w, e->io->blocked[i], 0);
+        }
+        w_puts(&w, ",\"turnaround\":");
+        w_int(&w, turnaround, 0);
+        w_puts(&w, ",\"response\":");
+        w_int(&w, response, 0);
+        w_putc(&w, '}');
+    }
+
+    engine_metrics(e, &m);
+    w_printf(&w, "],\"averages\":{\"waiting\":%.3f,\"turnaround\":%.3f,\"response\":%.3f",
+             m.avg_waiting, m.avg_turnaround, m.avg_response);
+    if(e->io) w_printf(&w, ",\"blocked\":%.3f", m.avg_blocked);
+    w_putc(&w, '}');
+    if(pol->flags & FAIRNESS) {
+        engine_fairness(e, &m);
+        w_printf(&w, ",\"fairness\":{\"jain\":%.4f,\"max_slowdown\":%.3f,\"share_error\":%.3f}",
+                 m.fairness, m.max_slowdown, m.share_error);
+    }
+    w_putc(&w, '}');
+    w_flush(&w);
+}
+
+void render_metrics_json(FILE *out, const Policy *pol, const Engine *e, int quantum) {
+    Writer w;
+    Metrics m;
+
+    engine_metrics(e, &m);
+    engine_fairness(e, &m);
+    writer_init(&w, out);
+    w_json_header(&w, pol, e, quantum);
+    w_printf(&w, ",\"metrics\":{\"waiting\":%.3f,\"turnaround\":%.3f,\"response\":%.3f,"
+             "\"throughput\":%.6f,\"cpu_utilization\":%.4f,\"switches\":%d,\"migrations\":%lld,"
+             "\"fairness\":%.4f,\"max_slowdown\":%.3f,\"share_error\":%.3f",
+             m.avg_waiting, m.avg_turnaround, m.avg_response, m.throughput, m.cpu_utilization, m.switches,
+             m.migrations, m.fairness, m.max_slowdown, m.share_error);
+    if(e->io) w_printf(&w, ",\"blocked\":%.3f", m.avg_blocked);
+    w_puts(&w, "}}");
+    w_flush(&w);
+}
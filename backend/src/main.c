@@ -3,35 +3,190 @@
 #include <string.h>
 #include "process.h"
 #include "scheduler.h"
+#include "server.h"
+#include "sweep.h"
+#include "stream.h"
+#include "render.h"
+#include "schedule_log.h"
+
+static void usage(const char *prog) {
+    printf("Usage: %s [--format=text|json] [--metrics] [--parallel] [--cpus=N [--global-queue] [--steal]] [--levels=N]\n"
+           "          [--seed=N] [--switch-cost=N] [--warmup=N] [--schedule-log=PREFIXE] fichier_processus.txt\n", prog);
+    printf("       %s --serve [--parallel] [--cache-dir=REPERTOIRE]\n", prog);
+    printf("       %s [--format=text|json] --sweep=Q1:Q2[:PAS] [--aging=A1:A2[:PAS]] [--levels=N] [--seed=N]\n"
+           "          [--switch-cost=N] [--warmup=N] fichier_processus.txt\n", prog);
+    printf("       %s [--format=text|json] --stream=CHOIX [--quantum=N] [--max-active=N] [--levels=N] [--seed=N]\n"
+           "          [--switch-cost=N] [--warmup=N] [fichier_processus.txt|-]\n", prog);
+}
+
+// Un journal par politique : PREFIXE-<numéro>.osched
+static void write_schedule_log(const char *prefix, const SchedRun *r, FILE *msg) {
+    char name[4096];
+    if (!r->ok) return;
+    snprintf(name, sizeof(name), "%s-%d.osched", prefix, r->policy);
+    if (!schedule_log_write(name, &r->e, r->policy, r->quantum))
+        fprintf(msg, "Erreur : impossible d'écrire le journal %s\n", name);
+}
 
 int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        printf("Usage: %s fichier_processus.txt\n", argv[0]);
+    OutputFormat format = FORMAT_TEXT;
+    int parallel = 0, serve = 0, sweep = 0, aging_set = 0, metrics = 0, levels = DEFAULT_LEVELS;
+    int stream = 0, stream_quantum = 0, max_active = DEFAULT_MAX_ACTIVE;
+    unsigned long long seed = DEFAULT_SEED;
+    Range quanta, aging = { 1, 1, 1 };
+    char *filename = NULL;
+    const char *cache_dir = NULL;
+    const char *log_prefix = NULL;
+    SmpConfig smp = { 1, 0, 0 };
+    SwitchCost cost = { 0, 0 };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format=json") == 0) {
+            format = FORMAT_JSON;
+        } else if (strcmp(argv[i], "--format=text") == 0) {
+            format = FORMAT_TEXT;
+        } else if (strcmp(argv[i], "--metrics") == 0) {
+            metrics = 1;
+        } else if (strcmp(argv[i], "--parallel") == 0) {
+            parallel = 1;
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            serve = 1;
+        } else if (strncmp(argv[i], "--cpus=", 7) == 0) {
+            smp.ncpu = atoi(argv[i] + 7);
+            if (smp.ncpu < 1 || smp.ncpu > 4096) {
+                fprintf(stderr, "Nombre de CPU invalide : %s\n", argv[i] + 7);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--levels=", 9) == 0) {
+            levels = atoi(argv[i] + 9);
+            if (levels < 1 || levels > MAX_LEVELS) {
+                fprintf(stderr, "Nombre de niveaux invalide : %s\n", argv[i] + 9);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            char *end;
+            seed = strtoull(argv[i] + 7, &end, 10);
+            if (end == argv[i] + 7 || *end != '\0') {
+                fprintf(stderr, "Graine invalide : %s\n", argv[i] + 7);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--switch-cost=", 14) == 0) {
+            cost.cost = atoi(argv[i] + 14);
+            if (cost.cost < 0 || cost.cost > 1000000) {
+                fprintf(stderr, "Coût de commutation invalide : %s\n", argv[i] + 14);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--warmup=", 9) == 0) {
+            cost.warmup = atoi(argv[i] + 9);
+            if (cost.warmup < 0 || cost.warmup > 1000000) {
+                fprintf(stderr, "Pénalité de réchauffement invalide : %s\n", argv[i] + 9);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--stream=", 9) == 0) {
+            stream = atoi(argv[i] + 9);
+            if (!find_policy(stream)) {
+                fprintf(stderr, "Choix invalide : %s\n", argv[i] + 9);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--quantum=", 10) == 0) {
+            stream_quantum = atoi(argv[i] + 10);
+            if (stream_quantum <= 0) {
+                fprintf(stderr, "Quantum invalide : %s\n", argv[i] + 10);
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--max-active=", 13) == 0) {
+            max_active = atoi(argv[i] + 13);
+            if (max_active < 1 || max_active > 100000000) {
+                fprintf(stderr, "Nombre de processus présents invalide : %s\n", argv[i] + 13);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--global-queue") == 0) {
+            smp.global_queue = 1;
+        } else if (strcmp(argv[i], "--steal") == 0) {
+            smp.steal = 1;
+        } else if (strncmp(argv[i], "--schedule-log=", 15) == 0) {
+            log_prefix = argv[i] + 15;
+        } else if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+            cache_dir = argv[i] + 12;
+        } else if (strncmp(argv[i], "--sweep=", 8) == 0) {
+            if (!parse_range(argv[i] + 8, &quanta)) {
+                fprintf(stderr, "Plage de quantum invalide : %s\n", argv[i] + 8);
+                return 1;
+            }
+            sweep = 1;
+        } else if (strncmp(argv[i], "--aging=", 8) == 0) {
+            if (!parse_range(argv[i] + 8, &aging)) {
+                fprintf(stderr, "Plage d'aging invalide : %s\n", argv[i] + 8);
+                return 1;
+            }
+            aging_set = 1;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            fprintf(stderr, "Option inconnue : %s\n", argv[i]);
+            usage(argv[0]);
+            return 1;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    if (serve)
+        return run_server(parallel, cache_dir);
+
+    // Flux : la trace n'est jamais chargée en entier, les processus sont simulés à mesure
+    if (stream) {
+        if (sweep || log_prefix || smp.ncpu > 1 || (find_policy(stream)->uses_quantum && stream_quantum == 0)) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (!run_stream(filename ? filename : "-", stream, stream_quantum, max_active, levels, seed, cost, format)) {
+            fprintf(stderr, "Erreur : simulation du flux interrompue\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    // Sans Gantt : seulement les indicateurs agrégés, en texte ou en JSON
+    if (metrics)
+        format = format == FORMAT_JSON ? FORMAT_METRICS_JSON : FORMAT_METRICS;
+
+    if (!filename || (aging_set && !sweep) || (log_prefix && sweep)) {
+        usage(argv[0]);
         return 1;
     }
 
-    char *filename = argv[1];
-    Process p[50];
-    Process original[50];
-    int n = 0;
+    // En JSON, stdout ne contient que le document : les messages vont sur stderr
+    FILE *msg = format_is_json(format) ? stderr : stdout;
+    ProcessTable table;
 
-    if (!lire_fichier_processus(filename, p, &n)) {
-        printf("Erreur : impossible de lire le fichier %s\n", filename);
+    if (!lire_fichier_processus(filename, &table)) {
+        fprintf(msg, "Erreur : impossible de lire le fichier %s\n", filename);
         return 1;
     }
 
-    memcpy(original, p, sizeof(p));
+    // Le balayage remplace le menu : toutes les politiques à quantum, toutes les valeurs
+    if (sweep) {
+        int ok = run_sweep(&table, quanta, aging, levels, seed, smp, cost, format);
+        if (!ok) fprintf(msg, "Erreur : mémoire insuffisante\n");
+        table_free(&table);
+        return ok ? 0 : 1;
+    }
 
-    printf("=== Mini Ordonnanceur Linux ===\n");
-    printf("1. FIFO\n");
-    printf("2. Round Robin\n");
-    printf("3. Priorité préemptive\n");
-    printf("4. Multi-Level avec aging\n");
-    printf("5. SJF\n");
-    printf("6. Priorité non préemptive\n");
-    printf("7. SRTF\n");
-    printf("\nVous pouvez entrer plusieurs choix séparés par des espaces (ex: 1 2 5 7)\n");
-    printf("Choix : ");
+    if (format == FORMAT_TEXT) {
+        printf("=== Mini Ordonnanceur Linux ===\n");
+        printf("1. FIFO\n");
+        printf("2. Round Robin\n");
+        printf("3. Priorité préemptive\n");
+        printf("4. Multi-Level avec aging\n");
+        printf("5. SJF\n");
+        printf("6. Priorité non préemptive\n");
+        printf("7. SRTF\n");
+        printf("8. CFS (Completely Fair Scheduler)\n");
+        printf("9. MLFQ (file multiniveau à retour)\n");
+        printf("10. Loterie\n");
+        printf("11. Stride\n");
+        printf("\nVous pouvez entrer plusieurs choix séparés par des espaces (ex: 1 2 5 7)\n");
+        printf("Choix : ");
+    }
 
     char line[256];
     if (!fgets(line, sizeof(line), stdin)) {
@@ -44,16 +199,16 @@ int main(int argc, char *argv[]) {
     char *token = strtok(line, " \t");
     while (token != NULL && nb_choices < 20) {
         int c = atoi(token);
-        if (c >= 1 && c <= 7) {
+        if (find_policy(c)) {
             choices[nb_choices++] = c;
         } else {
-            printf("Choix ignoré : %s\n", token);
+            fprintf(msg, "Choix ignoré : %s\n", token);
         }
         token = strtok(NULL, " \t");
     }
 
     if (nb_choices == 0) {
-        printf("Aucun choix valide.\n");
+        fprintf(msg, "Aucun choix valide.\n");
         choices[0] = 1;
         nb_choices = 1;
     }
@@ -61,23 +216,57 @@ int main(int argc, char *argv[]) {
     int quantum = 0;
     int need_quantum = 0;
     for (int i = 0; i < nb_choices; i++) {
-        if (choices[i] == 2 || choices[i] == 4) {
+        if (find_policy(choices[i])->uses_quantum) {
             need_quantum = 1;
             break;
         }
     }
     if (need_quantum) {
-        printf("Entrer le quantum : ");
+        if (format == FORMAT_TEXT)
+            printf("Entrer le quantum : ");
         if (scanf("%d", &quantum) != 1 || quantum <= 0) {
-            printf("Quantum invalide.\n");
+            fprintf(msg, "Quantum invalide.\n");
             return 1;
         }
     }
 
+    // En parallèle, chaque politique simule et se rend sur sa copie ; la sortie reste dans l'ordre demandé
+    SchedRun runs[20];
+    if (parallel) {
+        for (int i = 0; i < nb_choices; i++) {
+            sched_run_prepare(&runs[i], choices[i], &table, quantum, 1);
+            runs[i].smp = smp;
+            runs[i].levels = levels;
+            runs[i].seed = seed;
+            runs[i].cost = cost;
+        }
+        simulate_parallel(runs, nb_choices, format);
+    }
+
+    if (format_is_json(format))
+        printf("{\"results\":[");
+    else if (format == FORMAT_METRICS)
+        render_metrics_header(stdout);
+
     for (int i = 0; i < nb_choices; i++) {
         int choice = choices[i];
 
-        memcpy(p, original, sizeof(original));
+        if (!parallel) {
+            sched_run_prepare(&runs[i], choice, &table, quantum, 0);
+            runs[i].smp = smp;
+            runs[i].levels = levels;
+            runs[i].seed = seed;
+            runs[i].cost = cost;
+            sched_run_simulate(&runs[i]);
+        }
+        if (log_prefix) write_schedule_log(log_prefix, &runs[i], msg);
+
+        if (format != FORMAT_TEXT) {
+            if (i > 0 && format_is_json(format)) printf(",");
+            sched_run_render(&runs[i], format, stdout);
+            if (!parallel) sched_run_release(&runs[i]);
+            continue;
+        }
 
         printf("\n");
         printf("╔════════════════════════════════════════════════╗\n");
@@ -89,14 +278,30 @@ int main(int argc, char *argv[]) {
             case 5: printf("║                  5. SJF                        ║\n"); break;
             case 6: printf("║          6. Priorité non préemptive            ║\n"); break;
             case 7: printf("║                  7. SRTF                       ║\n"); break;
+            case 8: printf("║                  8. CFS                        ║\n"); break;
+            case 9: printf("║                  9. MLFQ                       ║\n"); break;
+            case 10: printf("║                 10. Loterie                    ║\n"); break;
+            case 11: printf("║                 11. Stride                     ║\n"); break;
         }
         printf("╚════════════════════════════════════════════════╝\n\n");
 
-        run_scheduler(choice, p, n, quantum);
+        sched_run_render(&runs[i], FORMAT_TEXT, stdout);
+        if (!parallel) sched_run_release(&runs[i]);
 
         printf("\n────────────────────────────────────────────────────────────\n\n");
     }
 
+    if (parallel)
+        for (int i = 0; i < nb_choices; i++)
+            sched_run_release(&runs[i]);
+
+    if (format != FORMAT_TEXT) {
+        if (format_is_json(format)) printf("]}\n");
+        table_free(&table);
+        return 0;
+    }
+
     printf("Tous les algorithmes sélectionnés ont été exécutés.\n");
+    table_free(&table);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "../include/metrics.h"
+#include "../include/nice.h"
+
+// Tas de processus actifs par fin virtuelle
+typedef struct {
+    int *proc;
+    double *key;
+    int size;
+} GpsHeap;
+
+static void gps_push(GpsHeap *h, int i, double key) {
+    int k = h->size++;
+    while(k > 0 && h->key[(k - 1) / 2] > key) {
+        h->proc[k] = h->proc[(k - 1) / 2];
+        h->key[k] = h->key[(k - 1) / 2];
+        k = (k - 1) / 2;
+    }
+    h->proc[k] = i;
+    h->key[k] = key;
+}
+
+static int gps_pop(GpsHeap *h) {
+    int top = h->proc[0], last = h->proc[--h->size], k = 0;
+    double key = h->key[h->size];
+    for(;;) {
+        int c = 2 * k + 1;
+        if(c >= h->size) break;
+        if(c + 1 < h->size && h->key[c + 1] < h->key[c]) c++;
+        if(key <= h->key[c]) break;
+        h->proc[k] = h->proc[c];
+        h->key[k] = h->key[c];
+        k = c;
+    }
+    h->proc[k] = last;
+    h->key[k] = key;
+    return top;
+}
+
+/*
+ * Partage idéal (GPS pondéré) : les CPU sont divisés en continu entre les
+ * présents au prorata de leur poids. Le temps virtuel v avance de
+ * ncpu / (somme des poids) par unité ; i reçoit poids * (v - v(arrivée)) et
+ * finit quand v atteint v(arrivée) + burst / poids. Avec plusieurs CPU, la
+ * limite d'un CPU par processus est ignorée, et les E/S aussi : la référence
+ * suppose des processus toujours prêts.
+ */
+typedef struct {
+    double *finish;          // date de fin de chaque processus
+    double *arrival_v;       // temps virtuel à son arrivée
+    double *t, *v, *rate;    // chronologie de v : à partir de t[k], v[k] + rate[k] * (date - t[k])
+    int count;
+} Gps;
+
+static void gps_point(Gps *g, double t, double v, double load, int ncpu) {
+    g->t[g->count] = t;
+    g->v[g->count] = v;
+    g->rate[g->count++] = load > 0 ? ncpu / load : 0;
+}
+
+static int gps_run(const Engine *e, Gps *g) {
+    Arena *a = e->arena;
+    int n = e->n > 0 ? e->n : 1;
+    GpsHeap h = { arena_alloc(a, sizeof(int) * n), arena_alloc(a, sizeof(double) * n), 0 };
+    double v = 0, t = 0, load = 0;
+    int next = 0, ncpu = e->smp.ncpu;
+
+    g->finish = arena_alloc(a, sizeof(double) * n);
+    g->arrival_v = arena_alloc(a, sizeof(double) * n);
+    g->t = arena_alloc(a, sizeof(double) * 2 * n);
+    g->v = arena_alloc(a, sizeof(double) * 2 * n);
+    g->rate = arena_alloc(a, sizeof(double) * 2 * n);
+    g->count = 0;
+    if(!h.proc || !h.key || !g->finish || !g->arrival_v || !g->t || !g->v || !g->rate) return 0;
+
+    while(next < e->n || h.size > 0) {
+        int i = h.size > 0 ? h.proc[0] : -1;
+        double end = i >= 0 ? t + (h.key[0] - v) * load / ncpu : 0;
+        if(i >= 0 && (next == e->n || end <= e->p[e->order[next]].arrival)) {
+            v = h.key[0];
+            gps_pop(&h);
+            g->finish[i] = t = end;
+            load -= nice_weight(e->p[i].priority);
+            gps_point(g, t, v, load, ncpu);
+            continue;
+        }
+        i = e->order[next++];
+        if(load > 0) v += (e->p[i].arrival - t) * ncpu / load;
+        t = e->p[i].arrival;
+        load += nice_weight(e->p[i].priority);
+        g->arrival_v[i] = v;
+        gps_point(g, t, v, load, ncpu);
+        gps_push(&h, i, v + (double)e->p[i].burst / nice_weight(e->p[i].priority));
+    }
+    return 1;
+}
+
+// Temps virtuel à la date t. Les segments viennent presque dans l'ordre des
+// dates : le curseur avance, et ne recherche par dichotomie qu'en cas de retour
+static double gps_virtual(const Gps *g, int *cursor, double t) {
+    int k = *cursor;
+    if(g->count == 0 || t < g->t[0]) return 0;
+    if(t < g->t[k]) {
+        int lo = 0, hi = k;
+        while(hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            if(g->t[mid] <= t) lo = mid;
+            else hi = mid;
+        }
+        k = lo;
+    }
+    while(k + 1 < g->count && g->t[k + 1] <= t) k++;
+    *cursor = k;
+    return g->v[k] + g->rate[k] * (t - g->t[k]);
+}
+
+// Service de i sous GPS à la date t
+static double gps_service(const Engine *e, const Gps *g, int *cursor, int i, double t) {
+    double s = (gps_virtual(g, cursor, t) - g->arrival_v[i]) * nice_weight(e->p[i].priority);
+    if(s < 0) return 0;
+    return s > e->p[i].burst ? e->p[i].burst : s;
+}
+
+/*
+ * Erreur de partage proportionnel : le plus grand retard ou la plus grande
+ * avance du service reçu sur le service GPS. L'écart croît quand i tourne et
+ * décroît quand il attend : ses extrêmes sont aux bornes de ses segments.
+ */
+static double share_error(const Engine *e, const Gps *g) {
+    ArenaMark scratch = arena_mark(e->arena);
+    long long *served = arena_calloc(e->arena, e->n > 0 ? e->n : 1, sizeof(long long));
+    double worst = 0;
+    int cursor = 0;
+
+    if(!served) return 0;
+    for(int k = 0; k < e->sched.count; k++) {
+        const Segment *s = &e->sched.seg[k];
+        double before = served[s->proc] - gps_service(e, g, &cursor, s->proc, s->start);
+        served[s->proc] += s->end - s->start;
+        double after = served[s->proc] - gps_service(e, g, &cursor, s->proc, s->end);
+        if(-before > worst) worst = -before;
+        if(after > worst) worst = after;
+    }
+    arena_reset(e->arena, scratch);
+    return worst;
+}
+
+/*
+ * Indice de Jain des rapports séjour réel / séjour sous GPS : 1 si chaque
+ * processus est retardé dans la même proportion par rapport au partage idéal.
+ */
+void engine_fairness(const Engine *e, Metrics *m) {
+    ArenaMark scratch = arena_mark(e->arena);
+    double sum = 0, sum2 = 0;
+    int count = 0;
+    Gps g;
+
+    m->fairness = 1;
+    m->share_error = 0;
+    if(gps_run(e, &g)) {
+        for(int i = 0; i < e->n; i++) {
+            double turnaround = e->finish[i] - e->p[i].arrival, fair = g.finish[i] - e->p[i].arrival;
+            if(fair <= 0) continue;
+            sum += turnaround / fair;
+            sum2 += (turnaround / fair) * (turnaround / fair);
+            count++;
+        }
+        if(sum2 > 0) m->fairness = sum * sum / (count * sum2);
+        m->share_error = share_error(e, &g);
+    }
+    arena_reset(e->arena, scratch);
+}
+
+void engine_metrics(const Engine *e, Metrics *m) {
+    double sum_wait = 0, sum_turn = 0, sum_resp = 0, sum_blocked = 0, busy = 0, max_slowdown = 0;
+    long long bursts = 0;
+
+    // Avec des E/S, le temps bloqué n'est pas de l'attente et chaque rafale a son temps de réponse
+    for(int i = 0; i < e->n; i++) {
+        long long turnaround = e->finish[i] - e->p[i].arrival, blocked = engine_blocked(e, i);
+        sum_turn += turnaround;
+        sum_wait += turnaround - e->p[i].burst - blocked;
+        sum_blocked += blocked;
+        busy += e->p[i].burst;
+        if(e->p[i].burst > 0 && (double)turnaround / e->p[i].burst > max_slowdown)
+            max_slowdown = (double)turnaround / e->p[i].burst;
+        if(e->start[i] >= 0) sum_resp += e->start[i] - e->p[i].arrival;
+        if(e->io) sum_resp += e->io->response[i];
+        bursts += 1 + e->p[i].nio;
+    }
+
+    int n = e->n > 0 ? e->n : 1;
+    m->avg_waiting = sum_wait / n;
+    m->avg_turnaround = sum_turn / n;
+    m->avg_response = sum_resp / (bursts > 0 ? bursts : 1);
+    m->avg_blocked = sum_blocked / n;
+    m->makespan = e->time;
+    m->throughput = e->time > 0 ? e->n / (double)e->time : 0;
+    m->ncpu = e->smp.ncpu;
+    m->cpu_utilization = e->time > 0 ? busy / ((double)e->time * m->ncpu) : 0;
+    m->migrations = e->stats.total_migrations;
+    m->overhead = e->overhead.switch_time + e->overhead.warmup_time;
+    m->max_slowdown = max_slowdown;
+    m->fairness = 1;
+    m->share_error = 0;
+    if(m->ncpu > 1) {
+        m->switches = 0;
+        for(int c = 0; c < m->ncpu; c++)
+            m->switches += schedule_switches(&e->stats.cpu_sched[c]);
+    } else {
+        m->switches = schedule_switches(&e->sched);
+    }
+}
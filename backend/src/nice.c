@@ -0,0 +1,19 @@
+#include "../include/nice.h"
+
+// Table sched_prio_to_weight du noyau, nice -20 à 19
+static const int prio_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+int nice_weight(int priority) {
+    if(priority < -20) priority = -20;
+    if(priority > 19) priority = 19;
+    return prio_to_weight[priority + 20];
+}
@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+#include <string.h>
+#include <sys/mman.h>
+#include "../include/process.h"
+
+int table_init(ProcessTable *t, int cap) {
+    if(cap < 16) cap = 16;
+    t->n = 0;
+    t->cap = cap;
+    t->order = NULL;
+    t->map = NULL;
+    t->map_len = 0;
+#ifdef PROFILE
+    t->load_time = 0;
+#endif
+    if(!arena_init(&t->arena, (size_t)cap * (sizeof(Process) + RUN_BYTES_PER_PROCESS) + 4096))
+        return 0;
+    t->p = arena_alloc(&t->arena, sizeof(Process) * cap);
+    if(t->p && pool_init(&t->names, &t->arena, cap)) return 1;
+    arena_free(&t->arena);
+    return 0;
+}
+
+Process *table_push(ProcessTable *t) {
+    if(t->n == t->cap) {
+        Process *bigger = arena_alloc(&t->arena, sizeof(Process) * t->cap * 2);
+        if(!bigger) return NULL;
+        memcpy(bigger, t->p, sizeof(Process) * t->n);
+        t->p = bigger;
+        t->cap *= 2;
+    }
+    Process *proc = &t->p[t->n];
+    memset(proc, 0, sizeof(Process));
+    t->order = NULL;
+    proc->id = ++t->n;
+    return proc;
+}
+
+void table_free(ProcessTable *t) {
+    if(t->map) munmap(t->map, t->map_len);
+    t->map = NULL;
+    arena_free(&t->arena);
+    t->p = NULL;
+    t->order = NULL;
+    t->n = t->cap = 0;
+}
+
+int process_first_burst(const Process *p) {
+    int first = p->burst;
+    for(int k = 0; k < p->nio; k++)
+        first -= p->io[k].cpu;
+    return first;
+}
+
+/*
+ * Tri par base, octet de poids faible d'abord, de clés de 64 bits : l'arrivée
+ * (signe inversé pour que les négatives passent devant) en haut, l'indice en
+ * bas. Chaque passe est stable, donc les arrivées égales gardent l'ordre de
+ * la table. Les octets identiques pour tous les processus ne coûtent pas de
+ * passe : des dates sous 65536 se trient en deux.
+ */
+int sort_by_arrival(const Process p[], int n, int order[], Arena *a) {
+    if(n <= 0) return 1;
+
+    ArenaMark scratch = arena_mark(a);
+    unsigned long long *key = arena_alloc(a, sizeof(unsigned long long) * n);
+    unsigned long long *tmp = arena_alloc(a, sizeof(unsigned long long) * n);
+    if(!key || !tmp) {
+        arena_reset(a, scratch);
+        return 0;
+    }
+
+    int count[4][256];
+    memset(count, 0, sizeof(count));
+    for(int i = 0; i < n; i++) {
+        unsigned arrival = (unsigned)p[i].arrival ^ 0x80000000u;
+        key[i] = (unsigned long long)arrival << 32 | (unsigned)i;
+        for(int b = 0; b < 4; b++)
+            count[b][(arrival >> (8 * b)) & 0xff]++;
+    }
+
+    for(int b = 0; b < 4; b++) {
+        int shift = 32 + 8 * b;
+        if(count[b][(key[0] >> shift) & 0xff] == n) continue;
+
+        int pos = 0;
+        for(int d = 0; d < 256; d++) {
+            int c = count[b][d];
+            count[b][d] = pos;
+            pos += c;
+        }
+        for(int i = 0; i < n; i++)
+            tmp[count[b][(key[i] >> shift) & 0xff]++] = key[i];
+        unsigned long long *swap = key;
+        key = tmp;
+        tmp = swap;
+    }
+
+    for(int i = 0; i < n; i++)
+        order[i] = (int)(key[i] & 0xffffffffu);
+    arena_reset(a, scratch);
+    return 1;
+}
+
+const int *table_order(ProcessTable *t) {
+    if(!t->order) {
+        int *order = arena_alloc(&t->arena, sizeof(int) * (t->n > 0 ? t->n : 1));
+        if(!order || !sort_by_arrival(t->p, t->n, order, &t->arena)) return NULL;
+        t->order = order;
+    }
+    return t->order;
+}
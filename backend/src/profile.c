@@ -0,0 +1,25 @@
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include "../include/profile.h"
+#include "../include/render.h"
+
+double prof_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Une ligne par politique, à part de la sortie : stdout reste un document valide
+void prof_report(FILE *out, const char *policy, int quantum, int ncpu, long long events,
+                 const ProfCounters *c, const ProfPhases *ph) {
+    Writer w;
+    writer_init(&w, out);
+    w_puts(&w, "{\"profile\":{\"policy\":");
+    w_json_string(&w, policy);
+    w_printf(&w, ",\"quantum\":%d,\"cpus\":%d,\"events\":%lld,\"decisions\":%lld,\"queue_ops\":%lld,"
+             "\"preemptions\":%lld,\"idle_skips\":%lld,\"idle_time\":%lld,\"output_bytes\":%lld,"
+             "\"load_ms\":%.3f,\"simulate_ms\":%.3f,\"render_ms\":%.3f}}\n",
+             quantum, ncpu, events, c->decisions, c->queue_ops, c->preemptions, c->idle_skips, c->idle_time,
+             ph->output_bytes, ph->load * 1000, ph->simulate * 1000, ph->render * 1000);
+    w_flush(&w);
+}
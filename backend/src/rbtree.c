@@ -0,0 +1,217 @@
+#include "../include/rbtree.h"
+
+static int rb_less(const RbTree *t, int a, int b) {
+    if(t->key[a] != t->key[b]) return t->key[a] < t->key[b];
+    if(t->rank) return t->rank[a] < t->rank[b];
+    return a < b;
+}
+
+static int subtree_min(const RbTree *t, int x) {
+    while(t->left[x] >= 0) x = t->left[x];
+    return x;
+}
+
+// Remplace le fils x de son parent par y (ou la racine)
+static void replace_child(RbTree *t, int x, int y) {
+    int p = t->parent[x];
+    if(p < 0) t->root = y;
+    else if(t->left[p] == x) t->left[p] = y;
+    else t->right[p] = y;
+    if(y >= 0) t->parent[y] = p;
+}
+
+static void rotate_left(RbTree *t, int x) {
+    int y = t->right[x];
+    t->right[x] = t->left[y];
+    if(t->left[y] >= 0) t->parent[t->left[y]] = x;
+    replace_child(t, x, y);
+    t->left[y] = x;
+    t->parent[x] = y;
+}
+
+static void rotate_right(RbTree *t, int x) {
+    int y = t->left[x];
+    t->left[x] = t->right[y];
+    if(t->right[y] >= 0) t->parent[t->right[y]] = x;
+    replace_child(t, x, y);
+    t->right[y] = x;
+    t->parent[x] = y;
+}
+
+static int is_red(const RbTree *t, int x) {
+    return x >= 0 && t->red[x];
+}
+
+int rb_init(RbTree *t, int cap, Arena *a) {
+    if(cap < 1) cap = 1;
+    t->left = arena_alloc(a, sizeof(int) * cap);
+    t->right = arena_alloc(a, sizeof(int) * cap);
+    t->parent = arena_alloc(a, sizeof(int) * cap);
+    t->red = arena_alloc(a, cap);
+    t->key = arena_alloc(a, sizeof(long long) * cap);
+    t->rank = NULL;
+    t->root = t->leftmost = -1;
+    t->size = 0;
+    if(!t->left || !t->right || !t->parent || !t->red || !t->key) return 0;
+    for(int i = 0; i < cap; i++) t->parent[i] = RB_ABSENT;
+    return 1;
+}
+
+static void insert_fixup(RbTree *t, int z) {
+    int p;
+    while(is_red(t, p = t->parent[z])) {
+        int g = t->parent[p];    // existe : la racine est noire
+        if(p == t->left[g]) {
+            int u = t->right[g];
+            if(is_red(t, u)) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+                continue;
+            }
+            if(z == t->right[p]) {
+                rotate_left(t, p);
+                z = p;
+                p = t->parent[z];
+            }
+            t->red[p] = 0;
+            t->red[g] = 1;
+            rotate_right(t, g);
+        } else {
+            int u = t->left[g];
+            if(is_red(t, u)) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+                continue;
+            }
+            if(z == t->left[p]) {
+                rotate_right(t, p);
+                z = p;
+                p = t->parent[z];
+            }
+            t->red[p] = 0;
+            t->red[g] = 1;
+            rotate_left(t, g);
+        }
+    }
+    t->red[t->root] = 0;
+}
+
+void rb_insert(RbTree *t, int i, long long key) {
+    int p = -1, x = t->root, leftmost = 1;
+
+    t->key[i] = key;
+    while(x >= 0) {
+        p = x;
+        if(rb_less(t, i, x)) {
+            x = t->left[x];
+        } else {
+            x = t->right[x];
+            leftmost = 0;
+        }
+    }
+
+    t->parent[i] = p;
+    t->left[i] = t->right[i] = -1;
+    t->red[i] = 1;
+    if(p < 0) t->root = i;
+    else if(rb_less(t, i, p)) t->left[p] = i;
+    else t->right[p] = i;
+    if(leftmost) t->leftmost = i;
+    t->size++;
+    insert_fixup(t, i);
+}
+
+// x (éventuellement absent) remplace un nœud noir retiré sous le parent xp
+static void remove_fixup(RbTree *t, int x, int xp) {
+    while(x != t->root && !is_red(t, x)) {
+        if(x == t->left[xp]) {
+            int w = t->right[xp];
+            if(t->red[w]) {
+                t->red[w] = 0;
+                t->red[xp] = 1;
+                rotate_left(t, xp);
+                w = t->right[xp];
+            }
+            if(!is_red(t, t->left[w]) && !is_red(t, t->right[w])) {
+                t->red[w] = 1;
+                x = xp;
+                xp = t->parent[x];
+                continue;
+            }
+            if(!is_red(t, t->right[w])) {
+                t->red[t->left[w]] = 0;
+                t->red[w] = 1;
+                rotate_right(t, w);
+                w = t->right[xp];
+            }
+            t->red[w] = t->red[xp];
+            t->red[xp] = 0;
+            t->red[t->right[w]] = 0;
+            rotate_left(t, xp);
+        } else {
+            int w = t->left[xp];
+            if(t->red[w]) {
+                t->red[w] = 0;
+                t->red[xp] = 1;
+                rotate_right(t, xp);
+                w = t->left[xp];
+            }
+            if(!is_red(t, t->left[w]) && !is_red(t, t->right[w])) {
+                t->red[w] = 1;
+                x = xp;
+                xp = t->parent[x];
+                continue;
+            }
+            if(!is_red(t, t->left[w])) {
+                t->red[t->right[w]] = 0;
+                t->red[w] = 1;
+                rotate_left(t, w);
+                w = t->left[xp];
+            }
+            t->red[w] = t->red[xp];
+            t->red[xp] = 0;
+            t->red[t->left[w]] = 0;
+            rotate_right(t, xp);
+        }
+        x = t->root;
+    }
+    if(x >= 0) t->red[x] = 0;
+}
+
+void rb_remove(RbTree *t, int z) {
+    int x, xp, removed_red;
+
+    // Le plus à gauche n'a pas de fils gauche : son successeur est à droite ou au-dessus
+    if(t->leftmost == z)
+        t->leftmost = t->right[z] >= 0 ? subtree_min(t, t->right[z]) : t->parent[z];
+
+    if(t->left[z] < 0 || t->right[z] < 0) {
+        x = t->left[z] >= 0 ? t->left[z] : t->right[z];
+        xp = t->parent[z];
+        removed_red = t->red[z];
+        replace_child(t, z, x);
+    } else {
+        // Deux fils : le successeur y prend la place de z
+        int y = subtree_min(t, t->right[z]);
+        removed_red = t->red[y];
+        x = t->right[y];
+        if(t->parent[y] == z) {
+            xp = y;
+        } else {
+            xp = t->parent[y];
+            replace_child(t, y, x);
+            t->right[y] = t->right[z];
+            t->parent[t->right[y]] = y;
+        }
+        replace_child(t, z, y);
+        t->left[y] = t->left[z];
+        t->parent[t->left[y]] = y;
+        t->red[y] = t->red[z];
+    }
+
+    if(!removed_red) remove_fixup(t, x, xp);
+    t->parent[z] = RB_ABSENT;
+    t->size--;
+}
@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include "../include/render.h"
+#include "../include/colors.h"
+#include "../include/writer.h"
+#include "../include/metrics.h"
+
+// Cellule occupée du processus i : "<couleur>█<reset> "
+static void busy_cell(char *cell, size_t size, int i) {
+    snprintf(cell, size, "%s█%s ", colors[i % 6], RESET);
+}
+
+static void print_busy(Writer *w, int i, long long from, long long to) {
+    char cell[32];
+    busy_cell(cell, sizeof(cell), i);
+    w_repeat(w, cell, to - from);
+}
+
+static void print_table(Writer *w, const Policy *pol, const Engine *e) {
+    const Process *p = e->p;
+
+    if(pol->flags & SHOW_PRIORITY) {
+        w_printf(w, "%-5s %-10s %-8s %-6s %-8s\n", "ID", "Process", "Arrival", "Burst", "Priority");
+        w_puts(w, "-----------------------------------------------------------------\n");
+        for(int i = 0; i < e->n; i++)
+            w_printf(w, "%-5d %-10s %-8d %-6d %-8d\n", p[i].id, p[i].name, p[i].arrival, p[i].burst, p[i].priority);
+    } else {
+        w_printf(w, "%-5s %-10s %-8s %-6s\n", "ID", "Process", "Arrival", "Burst");
+        w_puts(w, "-----------------------------------------------\n");
+        for(int i = 0; i < e->n; i++)
+            w_printf(w, "%-5d %-10s %-8d %-6d\n", p[i].id, p[i].name, p[i].arrival, p[i].burst);
+    }
+}
+
+static void print_switch_log(Writer *w, const Engine *e) {
+    const Schedule *s = &e->sched;
+    int current = -1;
+
+    for(int k = 0; k < s->count; k++) {
+        int i = s->seg[k].proc;
+        if(i != current) {
+            if(current != -1)
+                w_printf(w, "t=%lld → Changement vers %s\n", s->seg[k].start, e->p[i].name);
+            else
+                w_printf(w, "t=%lld → Début %s\n", s->seg[k].start, e->p[i].name);
+            current = i;
+        }
+        if(s->seg[k].end == e->finish[i])
+            w_printf(w, "t=%lld → %s terminé\n", s->seg[k].end, e->p[i].name);
+    }
+}
+
+static void print_gantt(Writer *w, const Policy *pol, const Engine *e) {
+    const Schedule *s = &e->sched;
+
+    w_puts(w, "Time : ");
+    for(long long t = 0; t < e->horizon; t++) {
+        w_int(w, t, 2);
+        w_putc(w, ' ');
+    }
+    w_putc(w, '\n');
+
+    if(pol->flags & ROW_PER_SEGMENT) {
+        for(int k = 0; k < s->count; k++) {
+            const Segment *seg = &s->seg[k];
+            w_str(w, e->p[seg->proc].name, -6);
+            w_puts(w, ": ");
+            w_repeat(w, " . ", seg->start);
+            print_busy(w, seg->proc, seg->start, seg->end);
+            w_repeat(w, " . ", e->horizon - seg->end);
+            w_putc(w, '\n');
+        }
+        return;
+    }
+
+    // Chaînage des segments de chaque processus, dans l'ordre du temps
+    int *first = arena_alloc(e->arena, sizeof(int) * (e->n + 1));
+    int *next = arena_alloc(e->arena, sizeof(int) * (s->count + 1));
+    if(!first || !next) return;
+    for(int i = 0; i < e->n; i++) first[i] = -1;
+    for(int k = s->count - 1; k >= 0; k--) {
+        next[k] = first[s->seg[k].proc];
+        first[s->seg[k].proc] = k;
+    }
+
+    for(int i = 0; i < e->n; i++) {
+        long long t = 0;
+        w_str(w, e->p[i].name, -6);
+        w_puts(w, ": ");
+        for(int k = first[i]; k >= 0; k = next[k]) {
+            w_repeat(w, " . ", s->seg[k].start - t);
+            print_busy(w, i, s->seg[k].start, s->seg[k].end);
+            t = s->seg[k].end;
+        }
+        w_repeat(w, " . ", e->horizon - t);
+        w_putc(w, '\n');
+    }
+}
+
+static void print_levels(Writer *w, const Engine *e) {
+    const Schedule *s = &e->sched;
+    int levels = 0;
+    for(int k = 0; k < s->count; k++)
+        if(s->seg[k].level > levels) levels = s->seg[k].level;
+
+    w_puts(w, "\nTimeline by Level:\n       ");
+    for(long long t = 0; t < e->horizon; t++)
+        w_int(w, t, -4);
+
+    for(int level = 1; level <= levels; level++) {
+        long long t = 0;
+        w_printf(w, "\nLevel %d ", level);
+        for(int k = 0; k < s->count; k++) {
+            if(s->seg[k].level != level) continue;
+            w_repeat(w, "    ", s->seg[k].start - t);
+            for(t = s->seg[k].start; t < s->seg[k].end; t++)
+                w_str(w, e->p[s->seg[k].proc].name, -4);
+        }
+        w_repeat(w, "    ", e->horizon - t);
+    }
+    w_putc(w, '\n');
+}
+
+// Une ligne par CPU : le processus de chaque unité de temps, puis l'occupation
+static void print_cpus(Writer *w, const Engine *e) {
+    w_puts(w, "\nTimeline by CPU:\n       ");
+    for(long long t = 0; t < e->horizon; t++)
+        w_int(w, t, -4);
+
+    for(int c = 0; c < e->smp.ncpu; c++) {
+        const Schedule *s = &e->stats.cpu_sched[c];
+        long long t = 0;
+        w_printf(w, "\nCPU%-3d ", c);
+        for(int k = 0; k < s->count; k++) {
+            w_repeat(w, "    ", s->seg[k].start - t);
+            for(t = s->seg[k].start; t < s->seg[k].end; t++)
+                w_str(w, e->p[s->seg[k].proc].name, -4);
+        }
+        w_repeat(w, "    ", e->horizon - t);
+    }
+
+    w_printf(w, "\n\n%-6s %-10s %-10s %-10s\n", "CPU", "Busy", "Util %", "Migrations");
+    for(int c = 0; c < e->smp.ncpu; c++)
+        w_printf(w, "%-6d %-10lld %-10.2f %-10lld\n", c, e->stats.busy[c],
+                 e->time > 0 ? 100.0 * e->stats.busy[c] / e->time : 0.0, e->stats.migrations[c]);
+    w_printf(w, "Migrations: %lld, steals: %lld\n", e->stats.total_migrations, e->stats.steals);
+}
+
+static void print_summary(Writer *w, const Engine *e) {
+    w_puts(w, "\nSummary:\n");
+    w_printf(w, "%-10s %-10s %-10s", "Process", "Waiting", "Turnaround");
+    w_puts(w, e->io ? " Blocked\n" : "\n");
+    for(int i = 0; i < e->n; i++) {
+        long long turnaround = e->finish[i] - e->p[i].arrival;
+        w_str(w, e->p[i].name, -10);
+        w_putc(w, ' ');
+        w_int(w, turnaround - e->p[i].burst - engine_blocked(e, i), -10);
+        w_putc(w, ' ');
+        w_int(w, turnaround, -10);
+        if(e->io) {
+            w_putc(w, ' ');
+            w_int(w, e->io->blocked[i], 0);
+        }
+        w_putc(w, '\n');
+    }
+}
+
+// Occupation de chaque périphérique : la somme des E/S qui lui sont adressées
+static void print_devices(Writer *w, const Engine *e) {
+    const IoState *io = e->io;
+    ArenaMark scratch = arena_mark(e->arena);
+    long long *busy = arena_calloc(e->arena, io->ndev, sizeof(long long));
+    long long *requests = arena_calloc(e->arena, io->ndev, sizeof(long long));
+
+    if(busy && requests) {
+        for(int i = 0; i < e->n; i++)
+            for(int k = 0; k < e->p[i].nio; k++) {
+                busy[e->p[i].io[k].device] += e->p[i].io[k].length;
+                requests[e->p[i].io[k].device]++;
+            }
+        w_printf(w, "\n%-8s %-10s %-10s %-10s\n", "Device", "Requests", "Busy", "Util %");
+        for(int d = 0; d < io->ndev; d++)
+            if(requests[d] > 0)
+                w_printf(w, "%-8d %-10lld %-10lld %-10.2f\n", d, requests[d], busy[d],
+                         e->time > 0 ? 100.0 * busy[d] / e->time : 0.0);
+    }
+    arena_reset(e->arena, scratch);
+}
+
+static void print_overhead(Writer *w, const Engine *e) {
+    long long total = e->overhead.switch_time + e->overhead.warmup_time;
+    w_printf(w, "\nContext switches: %lld (cost %d), cache warm-up up to %d\n", e->overhead.switches, e->cost.cost,
+             e->cost.warmup);
+    w_printf(w, "Overhead: %lld (switching %lld, warm-up %lld), %.2f%% of the makespan\n", total,
+             e->overhead.switch_time, e->overhead.warmup_time, e->time > 0 ? 100.0 * total / e->time : 0.0);
+}
+
+static void print_fairness(Writer *w, const Engine *e) {
+    Metrics m;
+    engine_metrics(e, &m);
+    engine_fairness(e, &m);
+    w_printf(w, "\nFairness (Jain, vs weighted fair share): %.4f\nMax slowdown: %.2f\n", m.fairness, m.max_slowdown);
+    w_printf(w, "Proportional-share error (max lag vs fair share): %.2f\n", m.share_error);
+}
+
+void render_text(FILE *out, const Policy *pol, const Engine *e, int quantum) {
+    Writer w;
+    int smp = e->smp.ncpu > 1;
+    writer_init(&w, out);
+
+    w_printf(&w, "\n================ %s", pol->title);
+    if(pol->uses_quantum) w_printf(&w, " (Quantum = %d)", quantum);
+    if(smp) w_printf(&w, " [%d CPU%s]", e->smp.ncpu, e->smp.global_queue ? ", file globale" : "");
+    w_puts(&w, " =================\n");
+
+    // Le journal et la chronologie par niveau supposent un seul CPU
+    if((pol->flags & SWITCH_LOG) && !smp)
+        print_switch_log(&w, e);
+    else
+        print_table(&w, pol, e);
+
+    w_puts(&w, "\nGantt Chart:\n");
+    print_gantt(&w, pol, e);
+
+    if(smp)
+        print_cpus(&w, e);
+    else if(pol->flags & LEVEL_TIMELINE)
+        print_levels(&w, e);
+
+    print_summary(&w, e);
+    if(e->io)
+        print_devices(&w, e);
+    if(e->sw)
+        print_overhead(&w, e);
+    if(pol->flags & FAIRNESS)
+        print_fairness(&w, e);
+
+    w_puts(&w, "================================================\n");
+    w_printf(&w, "End of %s scheduling.\n\n", pol->name);
+    w_flush(&w);
+}
+
+void render_metrics_header(FILE *out) {
+    fprintf(out, "%-28s %10s %10s %10s %10s %8s %10s %10s %10s %10s %9s %9s %9s\n", "Policy", "Waiting", "Turnaround",
+            "Response", "Throughput", "CPU %", "Switches", "Overhead", "Migrations", "Makespan", "Fairness", "Slowdown",
+            "Share err");
+}
+
+void render_metrics_text(FILE *out, const Policy *pol, const Engine *e, int quantum) {
+    char label[64];
+    Metrics m;
+
+    engine_metrics(e, &m);
+    engine_fairness(e, &m);
+    if(pol->uses_quantum) snprintf(label, sizeof(label), "%s (Q=%d)", pol->name, quantum);
+    else snprintf(label, sizeof(label), "%s", pol->name);
+    fprintf(out, "%-28s %10.3f %10.3f %10.3f %10.4f %8.2f %10d %10lld %10lld %10lld %9.4f %9.2f %9.2f\n", label,
+            m.avg_waiting, m.avg_turnaround, m.avg_response, m.throughput, m.cpu_utilization * 100, m.switches,
+            m.overhead, m.migrations, m.makespan, m.fairness, m.max_slowdown, m.share_error);
+}
@@ -0,0 +1,146 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/result_cache.h"
+
+// Deux voies indépendantes (FNV-1a et multiplication-rotation) : 128 bits
+static void mix(WorkloadKey *k, const void *data, size_t len) {
+    const unsigned char *b = data;
+    for(size_t i = 0; i < len; i++) {
+        k->h[0] = (k->h[0] ^ b[i]) * 0x100000001B3ULL;
+        k->h[1] = (k->h[1] ^ b[i]) * 0x9E3779B97F4A7C15ULL;
+        k->h[1] = (k->h[1] << 31) | (k->h[1] >> 33);
+    }
+}
+
+void workload_key(const ProcessTable *t, WorkloadKey *k) {
+    k->h[0] = 0xCBF29CE484222325ULL;
+    k->h[1] = 0x2545F4914F6CDD1DULL;
+    mix(k, &t->n, sizeof(t->n));
+    for(int i = 0; i < t->n; i++) {
+        const Process *p = &t->p[i];
+        int fields[3] = { p->arrival, p->burst, p->priority };
+        mix(k, p->name, strlen(p->name) + 1);
+        mix(k, fields, sizeof(fields));
+        mix(k, &p->nio, sizeof(p->nio));
+        mix(k, p->io, sizeof(IoBurst) * p->nio);
+    }
+}
+
+// Champ par champ : le remplissage des structures n'entre pas dans la clé
+void cache_key(const WorkloadKey *trace, const CacheParams *p, WorkloadKey *k) {
+    int version = CACHE_VERSION;
+    int fields[10] = { p->policy, p->quantum, p->aging, p->levels, p->smp.ncpu, p->smp.global_queue, p->smp.steal,
+                       p->cost.cost, p->cost.warmup, version };
+    *k = *trace;
+    mix(k, fields, sizeof(fields));
+    mix(k, &p->seed, sizeof(p->seed));
+}
+
+static int same_key(const CacheEntry *e, const WorkloadKey *k) {
+    return e->output && e->key.h[0] == k->h[0] && e->key.h[1] == k->h[1];
+}
+
+static void entry_path(const ResultCache *c, const WorkloadKey *k, char *path, size_t size) {
+    snprintf(path, size, "%s/v%d-%016llx%016llx.json", c->dir, CACHE_VERSION, k->h[0], k->h[1]);
+}
+
+void cache_init(ResultCache *c, const char *dir) {
+    memset(c, 0, sizeof(*c));
+    c->dir = dir;
+    if(dir) mkdir(dir, 0755);
+}
+
+void cache_free(ResultCache *c) {
+    for(int i = 0; i < CACHE_SLOTS; i++)
+        free(c->slots[i].output);
+    memset(c->slots, 0, sizeof(c->slots));
+    c->used = c->oldest = 0;
+    c->bytes = 0;
+}
+
+static void evict_oldest(ResultCache *c) {
+    CacheEntry *e = &c->slots[c->oldest];
+    c->bytes -= e->len;
+    free(e->output);
+    e->output = NULL;
+    c->oldest = (c->oldest + 1) % CACHE_SLOTS;
+    c->used--;
+}
+
+// Garde une copie en mémoire ; les trop gros résultats ne sont pas retenus
+static void remember(ResultCache *c, const WorkloadKey *k, const char *output, size_t len) {
+    if(len > CACHE_MAX_BYTES / 4) return;
+    char *copy = malloc(len);
+    if(!copy) return;
+    memcpy(copy, output, len);
+
+    while(c->used == CACHE_SLOTS || (c->used > 0 && c->bytes + len > CACHE_MAX_BYTES))
+        evict_oldest(c);
+
+    CacheEntry *e = &c->slots[(c->oldest + c->used) % CACHE_SLOTS];
+    e->key = *k;
+    e->output = copy;
+    e->len = len;
+    c->used++;
+    c->bytes += len;
+}
+
+static char *copy_output(const char *output, size_t len) {
+    char *copy = malloc(len > 0 ? len : 1);
+    if(copy) memcpy(copy, output, len);
+    return copy;
+}
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if(!f) return NULL;
+
+    struct stat st;
+    char *data = NULL;
+    if(fstat(fileno(f), &st) == 0 && st.st_size > 0 && (data = malloc(st.st_size))) {
+        if(fread(data, 1, st.st_size, f) == (size_t)st.st_size) {
+            *len = st.st_size;
+        } else {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    return data;
+}
+
+char *cache_get(ResultCache *c, const WorkloadKey *k, size_t *len) {
+    for(int n = 0; n < c->used; n++) {
+        const CacheEntry *e = &c->slots[(c->oldest + n) % CACHE_SLOTS];
+        if(same_key(e, k)) {
+            *len = e->len;
+            return copy_output(e->output, e->len);
+        }
+    }
+
+    if(!c->dir) return NULL;
+    char path[4096];
+    entry_path(c, k, path, sizeof(path));
+    char *data = read_file(path, len);
+    if(data) remember(c, k, data, *len);
+    return data;
+}
+
+void cache_put(ResultCache *c, const WorkloadKey *k, const char *output, size_t len) {
+    remember(c, k, output, len);
+    if(!c->dir) return;
+
+    // Écriture dans un fichier temporaire puis rename : un autre serveur ne lit jamais un fichier partiel
+    char path[4096], tmp[4160];
+    entry_path(c, k, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.%ld.tmp", path, (long)getpid());
+    FILE *f = fopen(tmp, "wb");
+    if(!f) return;
+    int ok = fwrite(output, 1, len, f) == len;
+    if(fclose(f) != 0) ok = 0;
+    if(!ok || rename(tmp, path) != 0) unlink(tmp);
+}
@@ -0,0 +1,72 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../include/schedule.h"
+
+int schedule_init(Schedule *s, Arena *a, int cap) {
+    if(cap < 16) cap = 16;
+    s->arena = a;
+    s->count = 0;
+    s->cap = cap;
+    s->cpu = 0;
+    s->seg = arena_alloc(a, sizeof(Segment) * cap);
+    return s->seg != NULL;
+}
+
+// Fusionne avec le segment précédent s'il prolonge le même processus au même niveau
+int schedule_add(Schedule *s, int proc, long long start, long long end, int level) {
+    if(s->count > 0) {
+        Segment *last = &s->seg[s->count - 1];
+        if(last->proc == proc && last->end == start && last->level == level) {
+            last->end = end;
+            return 1;
+        }
+    }
+
+    if(s->count == s->cap) {
+        Segment *bigger = arena_alloc(s->arena, sizeof(Segment) * s->cap * 2);
+        if(!bigger) return 0;
+        memcpy(bigger, s->seg, sizeof(Segment) * s->count);
+        s->seg = bigger;
+        s->cap *= 2;
+    }
+
+    Segment *seg = &s->seg[s->count++];
+    seg->proc = proc;
+    seg->start = start;
+    seg->end = end;
+    seg->level = level;
+    seg->cpu = s->cpu;
+    return 1;
+}
+
+int schedule_switches(const Schedule *s) {
+    int switches = 0;
+    for(int k = 1; k < s->count; k++)
+        if(s->seg[k].proc != s->seg[k - 1].proc) switches++;
+    return switches;
+}
+
+static int cmp_segment(const void *a, const void *b) {
+    const Segment *x = a, *y = b;
+    if(x->start != y->start) return x->start < y->start ? -1 : 1;
+    return x->cpu - y->cpu;
+}
+
+int schedule_merge(Schedule *dst, const Schedule src[], int count) {
+    int total = 0;
+    for(int c = 0; c < count; c++) total += src[c].count;
+
+    if(total > dst->cap) {
+        Segment *bigger = arena_alloc(dst->arena, sizeof(Segment) * total);
+        if(!bigger) return 0;
+        dst->seg = bigger;
+        dst->cap = total;
+    }
+    dst->count = 0;
+    for(int c = 0; c < count; c++) {
+        memcpy(dst->seg + dst->count, src[c].seg, sizeof(Segment) * src[c].count);
+        dst->count += src[c].count;
+    }
+    qsort(dst->seg, dst->count, sizeof(Segment), cmp_segment);
+    return 1;
+}
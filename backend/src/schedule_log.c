@@ -0,0 +1,331 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/schedule_log.h"
+#include "../include/writer.h"
+
+typedef struct {
+    Writer *w;
+    uint64_t offset;       // octets d'événements écrits
+    uint64_t count;
+    long long time;        // date et processus de l'événement précédent du bloc
+    int proc;
+    SchedLogIndex *index;
+    uint64_t nindex, index_cap;
+    uint64_t *cpu_block;   // bloc du dernier segment de chaque CPU
+    long long *cpu_end;    // et sa fin
+    int ncpu;
+} LogWriter;
+
+typedef struct {
+    long long time;
+    int proc;
+} Finish;
+
+static void put_varint(LogWriter *lw, uint64_t v) {
+    char buf[10];
+    int n = 0;
+    while(v >= 0x80) {
+        buf[n++] = (char)(v | 0x80);
+        v >>= 7;
+    }
+    buf[n++] = (char)v;
+    w_write(lw->w, buf, n);
+    lw->offset += n;
+}
+
+static uint64_t zigzag(long long v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static long long unzigzag(uint64_t v) {
+    return (long long)(v >> 1) ^ -(long long)(v & 1);
+}
+
+// Un segment commencé avant t et pas encore fini est le dernier de son CPU
+static int new_block(LogWriter *lw, long long time) {
+    if(lw->nindex == lw->index_cap) {
+        uint64_t cap = lw->index_cap ? lw->index_cap * 2 : 256;
+        SchedLogIndex *bigger = realloc(lw->index, sizeof(SchedLogIndex) * cap);
+        if(!bigger) return 0;
+        lw->index = bigger;
+        lw->index_cap = cap;
+    }
+    uint64_t live = lw->nindex;
+    for(int c = 0; c < lw->ncpu; c++)
+        if(lw->cpu_end[c] > time && lw->cpu_block[c] < live) live = lw->cpu_block[c];
+
+    SchedLogIndex *ix = &lw->index[lw->nindex++];
+    ix->time = time;
+    ix->offset = lw->offset;
+    ix->live_from = live;
+    lw->time = time;
+    lw->proc = 0;
+    return 1;
+}
+
+static int emit(LogWriter *lw, int kind, long long time, int proc, const Segment *s) {
+    if(lw->count % SCHED_LOG_BLOCK == 0 && !new_block(lw, time)) return 0;
+    put_varint(lw, (uint64_t)(time - lw->time) << 2 | (uint64_t)kind);
+    put_varint(lw, zigzag((long long)proc - lw->proc));
+    if(kind == LOG_SEGMENT) {
+        put_varint(lw, (uint64_t)s->cpu);
+        put_varint(lw, (uint64_t)(s->end - s->start));
+        put_varint(lw, zigzag(s->level));
+        lw->cpu_block[s->cpu] = lw->nindex - 1;
+        lw->cpu_end[s->cpu] = s->end;
+    }
+    lw->time = time;
+    lw->proc = proc;
+    lw->count++;
+    return 1;
+}
+
+static int cmp_finish(const void *a, const void *b) {
+    const Finish *x = a, *y = b;
+    if(x->time != y->time) return x->time < y->time ? -1 : 1;
+    return x->proc - y->proc;
+}
+
+// Fusion des trois suites triées ; à date égale, fins puis arrivées puis segments
+static int write_events(LogWriter *lw, const Engine *e) {
+    const Schedule *s = &e->sched;
+    Finish *fin = malloc(sizeof(Finish) * (e->n > 0 ? e->n : 1));
+    int nfin = 0, a = 0, f = 0, k = 0, ok = 1;
+
+    if(!fin) return 0;
+    for(int i = 0; i < e->n; i++)
+        if(e->finish[i] >= 0) {
+            fin[nfin].time = e->finish[i];
+            fin[nfin++].proc = i;
+        }
+    qsort(fin, nfin, sizeof(Finish), cmp_finish);
+
+    while(ok && (a < e->n || f < nfin || k < s->count)) {
+        long long ta = a < e->n ? e->p[e->order[a]].arrival : LLONG_MAX;
+        long long tf = f < nfin ? fin[f].time : LLONG_MAX;
+        long long ts = k < s->count ? s->seg[k].start : LLONG_MAX;
+        if(tf <= ta && tf <= ts) {
+            ok = emit(lw, LOG_FINISH, tf, fin[f].proc, NULL);
+            f++;
+        } else if(ta <= ts) {
+            ok = emit(lw, LOG_ARRIVAL, ta, e->order[a], NULL);
+            a++;
+        } else {
+            ok = emit(lw, LOG_SEGMENT, ts, s->seg[k].proc, &s->seg[k]);
+            k++;
+        }
+    }
+    free(fin);
+    return ok;
+}
+
+/*
+ * Les événements sont écrits au fil de l'eau ; l'index, la table des
+ * processus et les noms les suivent, puis l'en-tête est réécrit.
+ */
+int schedule_log_write(const char *filename, const Engine *e, int policy, int quantum) {
+    FILE *f = fopen(filename, "wb");
+    if(!f) return 0;
+
+    LogWriter lw;
+    memset(&lw, 0, sizeof(lw));
+    lw.ncpu = e->smp.ncpu;
+    lw.w = malloc(sizeof(Writer));
+    lw.cpu_block = calloc(lw.ncpu, sizeof(uint64_t));
+    lw.cpu_end = calloc(lw.ncpu, sizeof(long long));
+
+    SchedLogHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SCHED_LOG_MAGIC, sizeof(SCHED_LOG_MAGIC));
+    h.version = SCHED_LOG_VERSION;
+    h.block = SCHED_LOG_BLOCK;
+    h.ncpu = (uint32_t)lw.ncpu;
+    h.policy = policy;
+    h.quantum = quantum;
+    h.nproc = (uint64_t)e->n;
+    h.nsegments = (uint64_t)e->sched.count;
+    h.makespan = e->time;
+    h.events_offset = sizeof(h);
+
+    int ok = lw.w && lw.cpu_block && lw.cpu_end;
+    if(ok) {
+        writer_init(lw.w, f);
+        w_write(lw.w, (const char *)&h, sizeof(h));
+        ok = write_events(&lw, e);
+    }
+    if(ok) {
+        // Index et table alignés sur 8 octets pour être lus directement dans la projection
+        static const char zero[8];
+        h.nevents = lw.count;
+        h.events_size = lw.offset;
+        w_write(lw.w, zero, (8 - lw.offset % 8) % 8);
+        h.index_offset = h.events_offset + (lw.offset + 7) / 8 * 8;
+        w_write(lw.w, (const char *)lw.index, sizeof(SchedLogIndex) * lw.nindex);
+
+        h.procs_offset = h.index_offset + sizeof(SchedLogIndex) * lw.nindex;
+        for(int i = 0; i < e->n; i++) {
+            const Process *p = &e->p[i];
+            SchedLogProc rec = { p->id, p->arrival, p->burst, p->priority, e->start[i], e->finish[i], h.names_size };
+            w_write(lw.w, (const char *)&rec, sizeof(rec));
+            h.names_size += strlen(p->name) + 1;
+        }
+        h.names_offset = h.procs_offset + sizeof(SchedLogProc) * (uint64_t)e->n;
+        for(int i = 0; i < e->n; i++)
+            w_write(lw.w, e->p[i].name, strlen(e->p[i].name) + 1);
+        w_flush(lw.w);
+        ok = fseek(f, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, f) == 1;
+    }
+    ok = !ferror(f) && ok;
+    if(fclose(f) != 0) ok = 0;
+    free(lw.w);
+    free(lw.cpu_block);
+    free(lw.cpu_end);
+    free(lw.index);
+    return ok;
+}
+
+// Tailles vérifiées par divisions : un en-tête corrompu ne doit pas déborder
+static int log_valid(const SchedLogHeader *h, size_t size) {
+    if(memcmp(h->magic, SCHED_LOG_MAGIC, 8) != 0 || h->version != SCHED_LOG_VERSION) return 0;
+    if(h->block == 0 || h->ncpu == 0 || h->nproc > 0x7fffffff) return 0;
+    if(h->events_offset != sizeof(SchedLogHeader) || h->events_size > size) return 0;
+    if(h->index_offset != h->events_offset + (h->events_size + 7) / 8 * 8) return 0;
+
+    uint64_t nindex = h->nevents / h->block + (h->nevents % h->block != 0);
+    if(h->index_offset > size || nindex > (size - h->index_offset) / sizeof(SchedLogIndex)) return 0;
+    if(h->procs_offset != h->index_offset + nindex * sizeof(SchedLogIndex)) return 0;
+    if(h->nproc > (size - h->procs_offset) / sizeof(SchedLogProc)) return 0;
+    if(h->names_offset != h->procs_offset + h->nproc * sizeof(SchedLogProc)) return 0;
+    if(h->names_size != size - h->names_offset) return 0;
+    const char *names = (const char *)h + h->names_offset;
+    return h->names_size == 0 || names[h->names_size - 1] == '\0';
+}
+
+int schedule_log_open(SchedLog *l, const char *filename) {
+    memset(l, 0, sizeof(*l));
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) return 0;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SchedLogHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED) return 0;
+    l->map = map;
+    l->len = st.st_size;
+
+    const SchedLogHeader *h = map;
+    if(!log_valid(h, l->len)) {
+        schedule_log_close(l);
+        return 0;
+    }
+    l->h = h;
+    l->events = (const uint8_t *)map + h->events_offset;
+    l->index = (const SchedLogIndex *)((const char *)map + h->index_offset);
+    l->nindex = (h->procs_offset - h->index_offset) / sizeof(SchedLogIndex);
+    l->proc = (const SchedLogProc *)((const char *)map + h->procs_offset);
+    l->names = (const char *)map + h->names_offset;
+
+    for(uint64_t b = 0; b < l->nindex; b++)
+        if(l->index[b].offset >= h->events_size || l->index[b].live_from > b
+           || (b > 0 && (l->index[b].offset <= l->index[b - 1].offset || l->index[b].time < l->index[b - 1].time))) {
+            schedule_log_close(l);
+            return 0;
+        }
+    for(uint64_t i = 0; i < h->nproc; i++)
+        if(l->proc[i].name >= h->names_size) {
+            schedule_log_close(l);
+            return 0;
+        }
+    return 1;
+}
+
+void schedule_log_close(SchedLog *l) {
+    if(l->map) munmap(l->map, l->len);
+    l->map = NULL;
+}
+
+// Dernier bloc dont la date est <= t, ou 0
+static uint64_t block_at(const SchedLog *l, long long t) {
+    uint64_t lo = 0, hi = l->nindex;
+    while(lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if(l->index[mid].time <= t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo > 0 ? lo - 1 : 0;
+}
+
+// À date égale, des événements de date t peuvent finir le bloc précédent : on part du dernier bloc avant t
+uint64_t log_block_from(const SchedLog *l, long long t) {
+    if(l->nindex == 0) return 0;
+    uint64_t live = l->index[block_at(l, t)].live_from;
+    uint64_t before = t > LLONG_MIN ? block_at(l, t - 1) : 0;
+    return live < before ? live : before;
+}
+
+void log_seek(LogCursor *c, const SchedLog *l, uint64_t block) {
+    c->log = l;
+    c->event = block * l->h->block;
+    c->pos = block < l->nindex ? l->events + l->index[block].offset : l->events + l->h->events_size;
+    c->time = 0;
+    c->proc = 0;
+}
+
+static int get_varint(LogCursor *c, uint64_t *v) {
+    const uint8_t *end = c->log->events + c->log->h->events_size;
+    uint64_t r = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+        if(c->pos == end) return 0;
+        uint8_t b = *c->pos++;
+        r |= (uint64_t)(b & 0x7f) << shift;
+        if(!(b & 0x80)) {
+            *v = r;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int log_next(LogCursor *c, LogEvent *ev) {
+    const SchedLog *l = c->log;
+    uint64_t head, dproc, cpu, len, level;
+
+    if(c->event >= l->h->nevents) return 0;
+    if(c->event % l->h->block == 0) {
+        const SchedLogIndex *ix = &l->index[c->event / l->h->block];
+        if(c->pos != l->events + ix->offset) return -1;
+        c->time = ix->time;
+        c->proc = 0;
+    }
+    if(!get_varint(c, &head) || !get_varint(c, &dproc)) return -1;
+
+    long long proc = c->proc + unzigzag(dproc);
+    ev->kind = (int)(head & 3);
+    ev->time = c->time + (long long)(head >> 2);
+    if(ev->kind > LOG_FINISH || proc < 0 || proc >= (long long)l->h->nproc) return -1;
+    ev->proc = (int)proc;
+    ev->cpu = -1;
+    ev->end = ev->time;
+    ev->level = 0;
+    if(ev->kind == LOG_SEGMENT) {
+        if(!get_varint(c, &cpu) || !get_varint(c, &len) || !get_varint(c, &level) || cpu >= l->h->ncpu)
+            return -1;
+        ev->cpu = (int)cpu;
+        ev->end = ev->time + (long long)len;
+        ev->level = (int)unzigzag(level);
+    }
+    c->time = ev->time;
+    c->proc = ev->proc;
+    c->event++;
+    return 1;
+}
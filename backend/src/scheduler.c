@@ -1,26 +1,223 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 #include "../include/scheduler.h"
 #include "../include/process.h"
+#include "../include/render.h"
 
-void fifo(Process p[], int n);
-void round_robin(Process p[], int n, int quantum);
-void priority_preemptive(Process p[], int n);
-void priority_nonpreemptive(Process p[], int n);
-void multilevel(Process p[], int n, int quantum);
-void sjf(Process p[], int n);
-void srtf(Process p[], int n);
-
-void run_scheduler(int policy, Process p[], int n, int quantum) {
-    switch(policy) {
-        case 1: fifo(p, n); break;
-        case 2: round_robin(p, n, quantum); break;
-        case 3: priority_preemptive(p, n); break;
-        case 4: multilevel(p, n, quantum); break;
-        case 5: sjf(p, n); break;
-        case 6: priority_nonpreemptive(p, n); break;
-        case 7: srtf(p, n); break;
-        default: printf("Choix invalide.\n");
+int fifo(Engine *e, int quantum);
+int round_robin(Engine *e, int quantum);
+int priority_preemptive(Engine *e, int quantum);
+int priority_nonpreemptive(Engine *e, int quantum);
+int multilevel(Engine *e, int quantum);
+int sjf(Engine *e, int quantum);
+int srtf(Engine *e, int quantum);
+int cfs(Engine *e, int quantum);
+int mlfq(Engine *e, int quantum);
+int lottery(Engine *e, int quantum);
+int stride(Engine *e, int quantum);
+
+static const Policy policies[] = {
+    { 1, "FIFO", "FIFO Scheduler", 0, 0, ROW_PER_SEGMENT, fifo },
+    { 2, "Round Robin", "Round Robin Scheduler", 1, 0, ROW_PER_SEGMENT, round_robin },
+    { 3, "Priority Preemptive", "Priority Preemptive Scheduler", 0, 0, SHOW_PRIORITY | SWITCH_LOG, priority_preemptive },
+    { 4, "Multi-Level avec aging", "Multi-Level avec aging", 1, 1, SHOW_PRIORITY | LEVEL_TIMELINE, multilevel },
+    { 5, "SJF", "SJF Scheduler (Non-preemptive)", 0, 0, ROW_PER_SEGMENT, sjf },
+    { 6, "Priority Non-Preemptive", "Priority Non-Preemptive Scheduler", 0, 0, SHOW_PRIORITY | ROW_PER_SEGMENT, priority_nonpreemptive },
+    { 7, "SRTF", "SRTF Scheduler (Preemptive)", 0, 0, 0, srtf },
+    { 8, "CFS", "CFS Scheduler (Completely Fair)", 1, 0, SHOW_PRIORITY | FAIRNESS, cfs },
+    { 9, "MLFQ", "Multilevel Feedback Queue", 1, 1, SHOW_PRIORITY | LEVEL_TIMELINE, mlfq },
+    { 10, "Lottery", "Lottery Scheduler", 1, 0, SHOW_PRIORITY | FAIRNESS, lottery },
+    { 11, "Stride", "Stride Scheduler", 1, 0, SHOW_PRIORITY | FAIRNESS, stride },
+};
+
+const Policy *find_policy(int id) {
+    for(int k = 0; k < (int)(sizeof(policies) / sizeof(policies[0])); k++)
+        if(policies[k].id == id) return &policies[k];
+    return NULL;
+}
+
+const Policy *policy_list(int *count) {
+    *count = (int)(sizeof(policies) / sizeof(policies[0]));
+    return policies;
+}
+
+int sched_run_prepare(SchedRun *r, int policy, ProcessTable *t, int quantum, int private_copy) {
+    r->pol = find_policy(policy);
+    r->policy = policy;
+    r->quantum = quantum;
+    r->aging = 1;
+    r->levels = DEFAULT_LEVELS;
+    r->seed = DEFAULT_SEED;
+    r->smp.ncpu = 1;
+    r->smp.global_queue = r->smp.steal = 0;
+    r->cost.cost = r->cost.warmup = 0;
+    r->ok = 0;
+    r->prepared = 0;
+    r->private_copy = private_copy;
+    r->output = NULL;
+    r->output_len = 0;
+    r->checkpointing = 0;
+    r->resume_from = NULL;
+    r->p = t->p;
+    r->n = t->n;
+    r->arena = &t->arena;
+    r->order = table_order(t);
+#ifdef PROFILE
+    memset(&r->prof, 0, sizeof(r->prof));
+    r->prof.load = t->load_time;
+#endif
+
+    if(!r->pol) return 0;
+
+    // Chaque thread travaille sur sa propre copie : engine_run modifie remaining
+    if(private_copy) {
+        if(!arena_init(&r->own, (size_t)t->n * (sizeof(Process) + RUN_BYTES_PER_PROCESS) + 4096))
+            return 0;
+        r->arena = &r->own;
+        r->p = arena_alloc(r->arena, sizeof(Process) * (t->n > 0 ? t->n : 1));
+        if(!r->p) {
+            arena_free(&r->own);
+            r->private_copy = 0;
+            return 0;
+        }
+        memcpy(r->p, t->p, sizeof(Process) * t->n);
     }
+    r->prepared = 1;
+    return 1;
 }
 
+// Même politique, mêmes paramètres, et prev a gardé ses points de reprise
+static int resumable(const SchedRun *r, const SchedRun *prev) {
+    return prev && prev->ok && prev->e.checkpointing && r->smp.ncpu == 1 && prev->pol == r->pol
+        && (!r->pol->uses_quantum || prev->quantum == r->quantum) && prev->aging == r->aging
+        && prev->levels == r->levels && prev->seed == r->seed
+        && prev->cost.cost == r->cost.cost && prev->cost.warmup == r->cost.warmup;
+}
+
+void sched_run_simulate(SchedRun *r) {
+    if(!r->prepared) return;
+#ifdef PROFILE
+    double t0 = prof_now();
+#endif
+    r->ok = engine_init(&r->e, r->p, r->n, r->order, r->arena);
+    if(!r->ok) return;
+    r->e.aging = r->aging;
+    r->e.levels = r->levels;
+    r->e.rng = r->seed;
+    r->e.smp = r->smp;
+    r->e.cost = r->cost;
+    r->e.checkpointing = r->checkpointing && r->smp.ncpu == 1;
+    if(resumable(r, r->resume_from)) r->ok = engine_resume(&r->e, &r->resume_from->e);
+    if(r->ok) r->ok = r->pol->simulate(&r->e, r->quantum);
+#ifdef PROFILE
+    r->prof.simulate = prof_now() - t0;
+#endif
+}
+
+static void render_to(SchedRun *r, OutputFormat format, FILE *out) {
+    if(!r->pol) {
+        if(format_is_json(format)) fprintf(out, "{\"id\":%d,\"error\":\"choix invalide\"}", r->policy);
+        else fprintf(out, "Choix invalide.\n");
+        return;
+    }
+    if(!r->ok) {
+        if(format_is_json(format)) fprintf(out, "{\"id\":%d,\"error\":\"mémoire insuffisante\"}", r->policy);
+        else fprintf(out, "Erreur : mémoire insuffisante\n");
+        return;
+    }
+
+    switch(format) {
+        case FORMAT_JSON:         render_json(out, r->pol, &r->e, r->quantum); break;
+        case FORMAT_METRICS:      render_metrics_text(out, r->pol, &r->e, r->quantum); break;
+        case FORMAT_METRICS_JSON: render_metrics_json(out, r->pol, &r->e, r->quantum); break;
+        default:                  render_text(out, r->pol, &r->e, r->quantum); break;
+    }
+}
 
+void sched_run_render(SchedRun *r, OutputFormat format, FILE *out) {
+#ifdef PROFILE
+    // Rendu en mémoire d'abord : sa durée et sa taille, sans l'écriture sur out
+    if(!r->output && r->prepared) sched_run_render_buffer(r, format);
+#endif
+    if(r->output) fwrite(r->output, 1, r->output_len, out);
+    else render_to(r, format, out);
+#ifdef PROFILE
+    if(r->prepared && r->ok)
+        prof_report(stderr, r->pol->name, r->pol->uses_quantum ? r->quantum : 0, r->e.smp.ncpu, r->e.events,
+                    &r->e.prof, &r->prof);
+#endif
+}
+
+void sched_run_release(SchedRun *r) {
+    free(r->output);
+    r->output = NULL;
+    if(r->prepared) engine_free(&r->e);
+    if(r->private_copy) arena_free(&r->own);
+}
+
+void run_scheduler(int policy, ProcessTable *t, int quantum, OutputFormat format) {
+    SchedRun r;
+    sched_run_prepare(&r, policy, t, quantum, 0);
+    sched_run_simulate(&r);
+    sched_run_render(&r, format, stdout);
+    sched_run_release(&r);
+}
+
+int sched_run_render_buffer(SchedRun *r, OutputFormat format) {
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *out = open_memstream(&buf, &len);
+    if(!out) return 0;
+#ifdef PROFILE
+    double t0 = prof_now();
+#endif
+    render_to(r, format, out);
+    if(fclose(out) != 0) {
+        free(buf);
+        return 0;
+    }
+    r->output = buf;
+    r->output_len = len;
+#ifdef PROFILE
+    r->prof.render = prof_now() - t0;
+    r->prof.output_bytes = (long long)len;
+#endif
+    return 1;
+}
+
+void sched_run_from_output(SchedRun *r, int policy, char *output, size_t len) {
+    memset(r, 0, sizeof(*r));
+    r->pol = find_policy(policy);
+    r->policy = policy;
+    r->aging = 1;
+    r->levels = DEFAULT_LEVELS;
+    r->seed = DEFAULT_SEED;
+    r->smp.ncpu = 1;
+    r->output = output;
+    r->output_len = len;
+}
+
+// Le rendu (surtout le JSON) coûte autant que la simulation : il est fait
+// dans le thread, vers un tampon mémoire propre à l'exécution
+static void *simulate_thread(void *arg) {
+    SchedRun *r = arg;
+    sched_run_simulate(r);
+    sched_run_render_buffer(r, r->format);
+    return NULL;
+}
+
+void simulate_parallel(SchedRun runs[], int count, OutputFormat format) {
+    pthread_t threads[count > 0 ? count : 1];
+    int started[count > 0 ? count : 1];
+
+    for(int i = 0; i < count; i++) {
+        runs[i].format = format;
+        started[i] = runs[i].private_copy && pthread_create(&threads[i], NULL, simulate_thread, &runs[i]) == 0;
+        if(!started[i] && runs[i].private_copy) sched_run_simulate(&runs[i]);
+    }
+    for(int i = 0; i < count; i++)
+        if(started[i]) pthread_join(threads[i], NULL);
+}
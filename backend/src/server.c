@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/server.h"
+#include "../include/process.h"
+#include "../include/scheduler.h"
+#include "../include/render.h"
+#include "../include/trace_reader.h"
+#include "../include/result_cache.h"
+
+#define MAX_CHOICES 20
+
+typedef struct {
+    char id[65];
+    int count;
+    int quantum;
+    int choices[MAX_CHOICES];
+    int nb_choices;
+} Request;
+
+static void reply_error(const char *id, const char *message) {
+    printf("{\"id\":");
+    json_print_string(stdout, id);
+    printf(",\"error\":");
+    json_print_string(stdout, message);
+    printf("}\n");
+    fflush(stdout);
+}
+
+static int parse_header(const char *line, const char *end, Request *req) {
+    char buf[512], algos[256];
+    size_t len = end - line;
+    if (len >= sizeof(buf)) return 0;
+    memcpy(buf, line, len);
+    buf[len] = '\0';
+
+    // Le nombre de lignes reste lu si la suite est invalide, pour sauter le corps
+    if (sscanf(buf, "SIMULATE %64s %d %d %255s", req->id, &req->count, &req->quantum, algos) != 4)
+        return 0;
+
+    req->nb_choices = 0;
+    for (char *tok = strtok(algos, ","); tok && req->nb_choices < MAX_CHOICES; tok = strtok(NULL, ","))
+        req->choices[req->nb_choices++] = atoi(tok);
+    return req->count >= 0;
+}
+
+static const char *validate(const Request *req) {
+    if (req->nb_choices == 0) return "aucun choix";
+    for (int i = 0; i < req->nb_choices; i++) {
+        const Policy *pol = find_policy(req->choices[i]);
+        if (!pol) return "choix invalide";
+        if (pol->uses_quantum && req->quantum <= 0) return "quantum invalide";
+    }
+    return NULL;
+}
+
+// Corps d'une requête rejetée : ses lignes ne doivent pas être prises pour des en-têtes
+static void skip_lines(TraceReader *r, int count) {
+    const char *line, *end;
+    for (int k = 0; k < count && trace_read_line(r, &line, &end); k++)
+        ;
+}
+
+// Lit toujours les nb_processus lignes de la requête, même invalides, pour rester synchronisé
+static const char *read_processes(TraceReader *r, const Request *req, ProcessTable *t) {
+    const char *error = NULL;
+    if (!table_init(t, req->count)) error = "mémoire insuffisante";
+
+    for (int k = 0; k < req->count; k++) {
+        const char *line, *end;
+        if (!trace_read_line(r, &line, &end)) return "requête tronquée";
+        if (error) continue;
+
+        Process proc;
+        int status = trace_parse_process(r, line, end, &t->names, &proc);
+        if (status < 0) {
+            error = "ligne de processus invalide";
+        } else if (status > 0) {
+            Process *slot = table_push(t);
+            if (!slot) {
+                error = "mémoire insuffisante";
+                continue;
+            }
+            proc.id = slot->id;
+            *slot = proc;
+        }
+    }
+    return error;
+}
+
+/*
+ * La requête précédente (table et exécutions) reste en mémoire : une
+ * nouvelle exécution de la même politique reprend au dernier point où le CPU
+ * était libre avant la première différence. Deux jeux alternent pour que les
+ * pointeurs vers les arènes restent valables.
+ */
+typedef struct {
+    ProcessTable table;
+    SchedRun runs[MAX_CHOICES];
+    int count;
+} Session;
+
+static void session_release(Session *s) {
+    for (int i = s->count - 1; i >= 0; i--)
+        sched_run_release(&s->runs[i]);
+    if (s->count >= 0) table_free(&s->table);
+    s->count = -1;
+}
+
+static const SchedRun *find_previous(const Session *prev, int policy) {
+    for (int i = 0; i < prev->count; i++)
+        if (prev->runs[i].policy == policy) return &prev->runs[i];
+    return NULL;
+}
+
+// Paramètres d'une exécution du serveur : ceux de sched_run_prepare, sans options
+static void run_key(const WorkloadKey *trace, int policy, int quantum, WorkloadKey *k) {
+    CacheParams p = { policy, find_policy(policy)->uses_quantum ? quantum : 0, 1, DEFAULT_LEVELS, DEFAULT_SEED,
+                      { 1, 0, 0 }, { 0, 0 } };
+    cache_key(trace, &p, k);
+}
+
+// Les résultats déjà en cache sont recopiés tels quels, les autres simulés puis mis en cache
+static void simulate_request(Session *cur, const Session *prev, const Request *req, int parallel,
+                             ResultCache *cache) {
+    WorkloadKey trace, keys[MAX_CHOICES];
+    int pending[MAX_CHOICES], nb_pending = 0;
+
+    workload_key(&cur->table, &trace);
+    for (int i = 0; i < req->nb_choices; i++) {
+        SchedRun *run = &cur->runs[i];
+        int policy = req->choices[i];
+        size_t len;
+        run_key(&trace, policy, req->quantum, &keys[i]);
+        char *cached = cache_get(cache, &keys[i], &len);
+        if (cached) {
+            sched_run_from_output(run, policy, cached, len);
+            continue;
+        }
+        pending[nb_pending++] = i;
+    }
+
+    int threads = parallel && nb_pending > 1;
+    for (int k = 0; k < nb_pending; k++) {
+        SchedRun *run = &cur->runs[pending[k]];
+        sched_run_prepare(run, req->choices[pending[k]], &cur->table, req->quantum, threads);
+        run->checkpointing = 1;
+        run->resume_from = find_previous(prev, req->choices[pending[k]]);
+    }
+    cur->count = req->nb_choices;
+
+    if (threads) {
+        simulate_parallel(cur->runs, req->nb_choices, FORMAT_JSON);
+    } else {
+        for (int k = 0; k < nb_pending; k++) {
+            SchedRun *run = &cur->runs[pending[k]];
+            sched_run_simulate(run);
+            sched_run_render_buffer(run, FORMAT_JSON);
+        }
+    }
+
+    for (int k = 0; k < nb_pending; k++) {
+        const SchedRun *run = &cur->runs[pending[k]];
+        if (run->ok && run->output)
+            cache_put(cache, &keys[pending[k]], run->output, run->output_len);
+    }
+
+    for (int i = 0; i < req->nb_choices; i++) {
+        if (i > 0) putchar(',');
+        sched_run_render(&cur->runs[i], FORMAT_JSON, stdout);
+    }
+}
+
+int run_server(int parallel, const char *cache_dir) {
+    TraceReader r;
+    if (!trace_open(&r, "-")) {
+        fprintf(stderr, "Erreur : mémoire insuffisante\n");
+        return 1;
+    }
+
+    static ResultCache cache;
+    cache_init(&cache, cache_dir);
+
+    Session sessions[2];
+    sessions[0].count = sessions[1].count = -1;
+    int cur = 0;
+
+    const char *line, *end;
+    while (trace_read_line(&r, &line, &end)) {
+        while (line < end && (end[-1] == '\r' || end[-1] == ' ')) end--;
+        if (line == end) continue;
+        if (end - line == 4 && memcmp(line, "QUIT", 4) == 0) break;
+
+        Request req;
+        memset(&req, 0, sizeof(req));
+        if (!parse_header(line, end, &req)) {
+            reply_error(req.id, "en-tête invalide");
+            skip_lines(&r, req.count);
+            continue;
+        }
+
+        Session *next = &sessions[1 - cur], *prev = &sessions[cur];
+        session_release(next);
+        const char *error = read_processes(&r, &req, &next->table);
+        next->count = 0;
+        if (!error) error = validate(&req);
+
+        if (error) {
+            reply_error(req.id, error);
+            session_release(next);
+            continue;
+        }
+
+        printf("{\"id\":");
+        json_print_string(stdout, req.id);
+        printf(",\"results\":[");
+        simulate_request(next, prev, &req, parallel, &cache);
+        printf("]}\n");
+        fflush(stdout);
+
+        // Les exécutions précédentes ne servent plus : la nouvelle requête devient la référence
+        session_release(prev);
+        cur = 1 - cur;
+    }
+
+    session_release(&sessions[0]);
+    session_release(&sessions[1]);
+    cache_free(&cache);
+    trace_close(&r);
+    return 0;
+}
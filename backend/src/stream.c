@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/stream.h"
+#include "../include/render.h"
+
+static int stream_open(Stream *s, const char *filename, int cap, Arena *a) {
+    memset(s, 0, sizeof(*s));
+    s->totals.last = -1;
+    s->cap = cap;
+    if(!trace_open(&s->reader, filename)) return 0;
+    if(!arena_init(&s->scratch, 4096)) return 0;
+    s->mark = arena_mark(&s->scratch);
+
+    s->p = arena_calloc(a, cap, sizeof(Process));
+    s->name = arena_calloc(a, cap, sizeof(char *));
+    s->name_cap = arena_calloc(a, cap, sizeof(size_t));
+    s->io = arena_calloc(a, cap, sizeof(IoBurst *));
+    s->io_cap = arena_calloc(a, cap, sizeof(int));
+    s->free_slots = arena_alloc(a, sizeof(int) * cap);
+    if(!s->p || !s->name || !s->name_cap || !s->io || !s->io_cap || !s->free_slots) return 0;
+    // La case 0 sort la première : tant qu'aucune n'est rendue, case = rang d'arrivée
+    for(int k = 0; k < cap; k++)
+        s->free_slots[k] = cap - 1 - k;
+    s->nfree = cap;
+    return 1;
+}
+
+static void stream_close(Stream *s) {
+    if(s->name)
+        for(int i = 0; i < s->cap; i++) {
+            free(s->name[i]);
+            free(s->io[i]);
+        }
+    arena_free(&s->scratch);
+    trace_close(&s->reader);
+}
+
+// Lit la prochaine ligne valide, dans la mémoire de travail effacée à chaque ligne
+static void read_ahead(Stream *s) {
+    TraceReader *r = &s->reader;
+    const char *line, *end;
+
+    for(;;) {
+        // Plus de ligne complète en tampon : la lecture peut attendre, ce qui est prêt part d'abord
+        if(!memchr(r->buf + r->pos, '\n', r->len - r->pos)) {
+            w_flush(s->out);
+            fflush(s->out->out);
+        }
+        if(!trace_read_line(r, &line, &end)) {
+            s->ended = 1;
+            return;
+        }
+        arena_reset(&s->scratch, s->mark);
+        if(!pool_init(&s->names, &s->scratch, 1)) {
+            s->ended = 1;
+            return;
+        }
+        if(trace_parse_process(r, line, end, &s->names, &s->ahead) != 1) continue;
+        if(s->ahead.arrival < s->last_arrival) {
+            fprintf(stderr, "%s:%d : ligne ignorée (arrivée antérieure à la précédente)\n", r->filename, r->line);
+            r->errors++;
+            continue;
+        }
+        s->last_arrival = s->ahead.arrival;
+        s->ahead.id = ++s->ids;
+        s->has_ahead = 1;
+        return;
+    }
+}
+
+long long stream_peek(Stream *s) {
+    if(!s->has_ahead && !s->ended) read_ahead(s);
+    return s->has_ahead ? s->ahead.arrival : LLONG_MAX;
+}
+
+int stream_admit(Stream *s) {
+    if(!s->has_ahead) return -1;
+    s->has_ahead = 0;
+    if(s->nfree == 0) {
+        fprintf(stderr, "Erreur : plus de %d processus présents à t=%d, lecture arrêtée (voir --max-active)\n",
+                s->cap, s->ahead.arrival);
+        s->ended = s->failed = 1;
+        return -1;
+    }
+
+    int i = s->free_slots[s->nfree - 1];
+    const Process *a = &s->ahead;
+    size_t len = strlen(a->name) + 1;
+    if(len > s->name_cap[i]) {
+        char *bigger = realloc(s->name[i], len);
+        if(!bigger) {
+            s->ended = s->failed = 1;
+            return -1;
+        }
+        s->name[i] = bigger;
+        s->name_cap[i] = len;
+    }
+    if(a->nio > s->io_cap[i]) {
+        IoBurst *bigger = realloc(s->io[i], sizeof(IoBurst) * a->nio);
+        if(!bigger) {
+            s->ended = s->failed = 1;
+            return -1;
+        }
+        s->io[i] = bigger;
+        s->io_cap[i] = a->nio;
+    }
+    memcpy(s->name[i], a->name, len);
+    if(a->nio > 0) memcpy(s->io[i], a->io, sizeof(IoBurst) * a->nio);
+
+    s->nfree--;
+    s->p[i] = *a;
+    s->p[i].name = s->name[i];
+    s->p[i].io = a->nio > 0 ? s->io[i] : NULL;
+    if(++s->totals.active > s->totals.peak) s->totals.peak = s->totals.active;
+    return i;
+}
+
+// Sans segments gardés : on compte au passage ce que schedule_switches compterait
+void stream_ran(Engine *e, int i, long long start, long long end) {
+    StreamTotals *t = &e->stream->totals;
+    if(end <= start) return;
+    t->busy += end - start;
+    if(t->last != -1 && t->last != i) t->switches++;
+    t->last = i;
+}
+
+static void write_process(Stream *s, const Engine *e, int i, long long waiting, long long blocked,
+                          long long turnaround, long long response) {
+    const Process *p = &e->p[i];
+    Writer *w = s->out;
+
+    if(s->format == FORMAT_TEXT) {
+        w_printf(w, "%-5d %-10s %-8d %-6d %-8lld %-8lld %-8lld %-8lld %-10lld %-8lld\n", p->id, p->name, p->arrival,
+                 p->burst, e->start[i], e->finish[i], waiting, blocked, turnaround, response);
+        return;
+    }
+    w_puts(w, "{\"pid\":");
+    w_int(w, p->id, 0);
+    w_puts(w, ",\"name\":");
+    w_json_string(w, p->name);
+    w_printf(w, ",\"arrival\":%d,\"burst\":%d,\"priority\":%d,\"start\":%lld,\"finish\":%lld,\"waiting\":%lld,"
+             "\"blocked\":%lld,\"turnaround\":%lld,\"response\":%lld}\n", p->arrival, p->burst, p->priority,
+             e->start[i], e->finish[i], waiting, blocked, turnaround, response);
+}
+
+void stream_retire(Engine *e, int i) {
+    Stream *s = e->stream;
+    StreamTotals *t = &s->totals;
+    const Process *p = &e->p[i];
+    long long turnaround = e->finish[i] - p->arrival, blocked = engine_blocked(e, i);
+    long long waiting = turnaround - p->burst - blocked;
+    long long response = e->start[i] >= 0 ? e->start[i] - p->arrival : 0;
+
+    write_process(s, e, i, waiting, blocked, turnaround, response);
+    t->count++;
+    t->sum_waiting += waiting;
+    t->sum_turnaround += turnaround;
+    t->sum_blocked += blocked;
+    t->sum_response += response + (e->io ? e->io->response[i] : 0);
+    t->bursts += 1 + p->nio;
+    if(p->burst > 0 && (double)turnaround / p->burst > t->max_slowdown)
+        t->max_slowdown = (double)turnaround / p->burst;
+}
+
+void stream_release(Engine *e, int i) {
+    Stream *s = e->stream;
+    // Le prochain occupant de la case est un autre processus
+    if(s->totals.last == i) s->totals.last = -2;
+    s->free_slots[s->nfree++] = i;
+    s->totals.active--;
+}
+
+static void write_header(const Stream *s, const Policy *pol, int quantum) {
+    Writer *w = s->out;
+    if(s->format != FORMAT_TEXT) return;
+    w_printf(w, "=== Flux : %s", pol->name);
+    if(pol->uses_quantum) w_printf(w, " (Q=%d)", quantum);
+    w_printf(w, ", %d processus présents au plus ===\n", s->cap);
+    w_printf(w, "%-5s %-10s %-8s %-6s %-8s %-8s %-8s %-8s %-10s %-8s\n", "ID", "Process", "Arrival", "Burst", "Start",
+             "Finish", "Waiting", "Blocked", "Turnaround", "Response");
+}
+
+static void write_summary(const Stream *s, const Engine *e) {
+    const StreamTotals *t = &s->totals;
+    Writer *w = s->out;
+    double n = t->count > 0 ? (double)t->count : 1;
+    double response = t->sum_response / (t->bursts > 0 ? t->bursts : 1);
+    double throughput = e->time > 0 ? t->count / (double)e->time : 0;
+    double cpu = e->time > 0 ? (double)t->busy / e->time : 0;
+    long long overhead = e->overhead.switch_time + e->overhead.warmup_time;
+
+    if(s->format == FORMAT_TEXT) {
+        w_printf(w, "\nProcesses: %lld, peak active: %d, invalid lines: %d\n", t->count, t->peak, s->reader.errors);
+        w_printf(w, "Average waiting: %.3f, turnaround: %.3f, response: %.3f, blocked: %.3f\n",
+                 t->sum_waiting / n, t->sum_turnaround / n, response, t->sum_blocked / n);
+        w_printf(w, "Throughput: %.4f, CPU: %.2f%%, switches: %lld, overhead: %lld, makespan: %lld, max slowdown: %.2f\n",
+                 throughput, cpu * 100, t->switches, overhead, e->time, t->max_slowdown);
+        return;
+    }
+    w_printf(w, "{\"summary\":{\"processes\":%lld,\"peak_active\":%d,\"invalid_lines\":%d,\"waiting\":%.3f,"
+             "\"turnaround\":%.3f,\"response\":%.3f,\"blocked\":%.3f,\"throughput\":%.6f,\"cpu_utilization\":%.4f,"
+             "\"switches\":%lld,\"overhead\":%lld,\"makespan\":%lld,\"max_slowdown\":%.3f}}\n",
+             t->count, t->peak, s->reader.errors, t->sum_waiting / n, t->sum_turnaround / n, response,
+             t->sum_blocked / n, throughput, cpu, t->switches, overhead, e->time, t->max_slowdown);
+}
+
+/*
+ * Une ligne par processus, dans l'ordre des fins, puis le bilan. Le moteur
+ * ne garde ni segments ni points de reprise : pas de Gantt, et la table de
+ * processus n'est jamais complète.
+ */
+int run_stream(const char *filename, int policy, int quantum, int max_active, int levels, unsigned long long seed,
+               SwitchCost cost, OutputFormat format) {
+    const Policy *pol = find_policy(policy);
+    Writer *w = malloc(sizeof(Writer));
+    Arena arena;
+    Stream s;
+    Engine e;
+    int ok = 0;
+
+    if(!pol || !w) {
+        free(w);
+        return 0;
+    }
+    writer_init(w, stdout);
+    if(!arena_init(&arena, (size_t)max_active * (sizeof(Process) + RUN_BYTES_PER_PROCESS) + 4096)) {
+        free(w);
+        return 0;
+    }
+
+    if(stream_open(&s, filename, max_active, &arena)) {
+        s.format = format_is_json(format) ? FORMAT_JSON : FORMAT_TEXT;
+        s.out = w;
+        if(engine_init(&e, s.p, max_active, NULL, &arena)) {
+            e.levels = levels;
+            e.rng = seed;
+            e.cost = cost;
+            write_header(&s, pol, quantum);
+            ok = engine_stream(&e, &s) && pol->simulate(&e, quantum) && !s.failed;
+            write_summary(&s, &e);
+            engine_free(&e);
+        }
+    } else {
+        fprintf(stderr, "Erreur : impossible de lire %s\n", filename);
+    }
+    w_flush(w);
+    fflush(stdout);
+    stream_close(&s);
+    arena_free(&arena);
+    free(w);
+    return ok;
+}
@@ -0,0 +1,82 @@
+#include <string.h>
+#include "../include/strpool.h"
+
+static unsigned hash_bytes(const char *s, size_t len) {
+    unsigned h = 2166136261u;
+    for(size_t k = 0; k < len; k++) {
+        h ^= (unsigned char)s[k];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int pool_alloc_slots(StringPool *sp, int cap) {
+    sp->slots = arena_alloc(sp->arena, sizeof(int) * cap);
+    sp->hashes = arena_alloc(sp->arena, sizeof(unsigned) * cap);
+    if(!sp->slots || !sp->hashes) return 0;
+    memset(sp->slots, 0xff, sizeof(int) * cap);
+    sp->cap = cap;
+    return 1;
+}
+
+int pool_init(StringPool *sp, Arena *a, int cap) {
+    int pow2 = 64;
+    while(pow2 < cap * 2) pow2 *= 2;
+    sp->arena = a;
+    sp->count = 0;
+    sp->strings_cap = 64;
+    sp->strings = arena_alloc(a, sizeof(const char *) * sp->strings_cap);
+    return sp->strings && pool_alloc_slots(sp, pow2);
+}
+
+static int pool_grow(StringPool *sp) {
+    int *old = sp->slots;
+    unsigned *old_hashes = sp->hashes;
+    int old_cap = sp->cap;
+
+    if(!pool_alloc_slots(sp, old_cap * 2)) return 0;
+    for(int k = 0; k < old_cap; k++) {
+        if(old[k] < 0) continue;
+        unsigned slot = old_hashes[k] & (sp->cap - 1);
+        while(sp->slots[slot] >= 0) slot = (slot + 1) & (sp->cap - 1);
+        sp->slots[slot] = old[k];
+        sp->hashes[slot] = old_hashes[k];
+    }
+    return 1;
+}
+
+int pool_id(StringPool *sp, const char *s, size_t len) {
+    if(sp->count * 2 >= sp->cap && !pool_grow(sp)) return -1;
+
+    unsigned h = hash_bytes(s, len);
+    unsigned slot = h & (sp->cap - 1);
+    while(sp->slots[slot] >= 0) {
+        const char *name = sp->strings[sp->slots[slot]];
+        if(sp->hashes[slot] == h && strncmp(name, s, len) == 0 && name[len] == '\0')
+            return sp->slots[slot];
+        slot = (slot + 1) & (sp->cap - 1);
+    }
+
+    if(sp->count == sp->strings_cap) {
+        const char **bigger = arena_alloc(sp->arena, sizeof(const char *) * sp->strings_cap * 2);
+        if(!bigger) return -1;
+        memcpy(bigger, sp->strings, sizeof(const char *) * sp->count);
+        sp->strings = bigger;
+        sp->strings_cap *= 2;
+    }
+
+    char *copy = arena_alloc(sp->arena, len + 1);
+    if(!copy) return -1;
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+
+    sp->strings[sp->count] = copy;
+    sp->slots[slot] = sp->count;
+    sp->hashes[slot] = h;
+    return sp->count++;
+}
+
+const char *pool_intern(StringPool *sp, const char *s, size_t len) {
+    int id = pool_id(sp, s, len);
+    return id < 0 ? NULL : sp->strings[id];
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/sweep.h"
+#include "../include/metrics.h"
+#include "../include/render.h"
+#include "../include/taskpool.h"
+
+typedef struct {
+    const Policy *pol;
+    int quantum;
+    int aging;           // 0 : la politique ne vieillit pas
+    int ok;
+    Metrics m;
+} SweepConfig;
+
+typedef struct {
+    SweepConfig *configs;
+    ProcessTable *table;
+    int levels;
+    unsigned long long seed;
+    SmpConfig smp;
+    SwitchCost cost;
+} SweepJob;
+
+int parse_range(const char *text, Range *r) {
+    char extra;
+    int n = sscanf(text, "%d:%d:%d%c", &r->first, &r->last, &r->step, &extra);
+    if(n == 1) r->last = r->first;
+    if(n < 3) r->step = 1;
+    if(n < 1 || n > 3) return 0;
+    return r->first > 0 && r->last >= r->first && r->step > 0;
+}
+
+static int range_size(Range r) {
+    return (r.last - r.first) / r.step + 1;
+}
+
+// Chaque tâche simule sur sa propre copie de la table
+static void sweep_task(void *ctx, int task) {
+    SweepJob *job = ctx;
+    SweepConfig *c = &job->configs[task];
+    SchedRun r;
+
+    if(!sched_run_prepare(&r, c->pol->id, job->table, c->quantum, 1)) return;
+    if(c->aging > 0) r.aging = c->aging;
+    r.levels = job->levels;
+    r.seed = job->seed;
+    r.smp = job->smp;
+    r.cost = job->cost;
+    sched_run_simulate(&r);
+    if(r.ok) {
+        engine_metrics(&r.e, &c->m);
+        c->ok = 1;
+    }
+    sched_run_release(&r);
+}
+
+static void print_text(const SweepConfig *c, int count, int threads) {
+    printf("=== Balayage : %d configurations, %d thread(s) ===\n", count, threads);
+    printf("%-24s %8s %6s %12s %15s %10s %10s %10s\n", "Policy", "Quantum", "Aging", "Avg waiting", "Avg turnaround",
+           "Switches", "Overhead", "Throughput");
+    for(int k = 0; k < count; k++) {
+        printf("%-24s %8d ", c[k].pol->name, c[k].quantum);
+        if(c[k].aging > 0) printf("%6d ", c[k].aging);
+        else printf("%6s ", "-");
+        if(c[k].ok)
+            printf("%12.3f %15.3f %10d %10lld %10.4f\n", c[k].m.avg_waiting, c[k].m.avg_turnaround, c[k].m.switches,
+                   c[k].m.overhead, c[k].m.throughput);
+        else
+            printf("%12s %15s %10s %10s %10s\n", "erreur", "-", "-", "-", "-");
+    }
+}
+
+static void print_json(const SweepConfig *c, int count) {
+    printf("{\"sweep\":[");
+    for(int k = 0; k < count; k++) {
+        if(k > 0) putchar(',');
+        printf("{\"id\":%d,\"name\":", c[k].pol->id);
+        json_print_string(stdout, c[k].pol->name);
+        printf(",\"quantum\":%d", c[k].quantum);
+        if(c[k].aging > 0) printf(",\"aging\":%d", c[k].aging);
+        if(c[k].ok)
+            printf(",\"waiting\":%.3f,\"turnaround\":%.3f,\"switches\":%d,\"overhead\":%lld,\"throughput\":%.6f}",
+                   c[k].m.avg_waiting, c[k].m.avg_turnaround, c[k].m.switches, c[k].m.overhead, c[k].m.throughput);
+        else
+            printf(",\"error\":\"mémoire insuffisante\"}");
+    }
+    printf("]}\n");
+}
+
+int run_sweep(ProcessTable *t, Range quanta, Range aging, int levels, unsigned long long seed, SmpConfig smp,
+              SwitchCost cost, OutputFormat format) {
+    int npol;
+    const Policy *pols = policy_list(&npol);
+
+    int count = 0;
+    for(int k = 0; k < npol; k++)
+        if(pols[k].uses_quantum)
+            count += range_size(quanta) * (pols[k].uses_aging ? range_size(aging) : 1);
+
+    SweepConfig *configs = calloc(count > 0 ? count : 1, sizeof(SweepConfig));
+    if(!configs) return 0;
+
+    int c = 0;
+    for(int k = 0; k < npol; k++) {
+        if(!pols[k].uses_quantum) continue;
+        for(int q = quanta.first; q <= quanta.last; q += quanta.step) {
+            if(!pols[k].uses_aging) {
+                configs[c].pol = &pols[k];
+                configs[c++].quantum = q;
+                continue;
+            }
+            for(int a = aging.first; a <= aging.last; a += aging.step) {
+                configs[c].pol = &pols[k];
+                configs[c].quantum = q;
+                configs[c++].aging = a;
+            }
+        }
+    }
+
+    // Trié une fois ici : les tâches ne font que lire l'ordre de la table
+    if(!table_order(t)) {
+        free(configs);
+        return 0;
+    }
+    SweepJob job = { configs, t, levels, seed, smp, cost };
+    int threads = taskpool_default_threads();
+    if(!taskpool_run(count, threads, sweep_task, &job)) {
+        free(configs);
+        return 0;
+    }
+
+    if(threads > count) threads = count;
+    if(format_is_json(format)) print_json(configs, count);
+    else print_text(configs, count, threads);
+
+    free(configs);
+    return 1;
+}
@@ -0,0 +1,98 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/taskpool.h"
+
+// File d'un thread : le propriétaire prend en queue, les voleurs en tête
+typedef struct {
+    pthread_mutex_t lock;
+    int head, tail;
+} TaskDeque;
+
+typedef struct {
+    TaskDeque *deques;
+    int nthreads;
+    TaskFn fn;
+    void *ctx;
+} TaskPool;
+
+typedef struct {
+    TaskPool *pool;
+    int self;
+} TaskWorker;
+
+// Les tâches d'une file sont les indices [head, tail) : pas de tableau à gérer
+static int pop_own(TaskDeque *d) {
+    int task = -1;
+    pthread_mutex_lock(&d->lock);
+    if(d->head < d->tail) task = --d->tail;
+    pthread_mutex_unlock(&d->lock);
+    return task;
+}
+
+static int steal(TaskDeque *d) {
+    int task = -1;
+    pthread_mutex_lock(&d->lock);
+    if(d->head < d->tail) task = d->head++;
+    pthread_mutex_unlock(&d->lock);
+    return task;
+}
+
+static void *worker_main(void *arg) {
+    TaskWorker *w = arg;
+    TaskPool *pool = w->pool;
+
+    for(;;) {
+        int task = pop_own(&pool->deques[w->self]);
+        // Aucune tâche n'est créée en cours de route : toutes les files vides = fini
+        for(int k = 1; task < 0 && k < pool->nthreads; k++)
+            task = steal(&pool->deques[(w->self + k) % pool->nthreads]);
+        if(task < 0) return NULL;
+        pool->fn(pool->ctx, task);
+    }
+}
+
+int taskpool_run(int count, int nthreads, TaskFn fn, void *ctx) {
+    if(count <= 0) return 1;
+    if(nthreads > count) nthreads = count;
+    if(nthreads < 1) nthreads = 1;
+
+    TaskPool pool = { calloc(nthreads, sizeof(TaskDeque)), nthreads, fn, ctx };
+    TaskWorker *workers = calloc(nthreads, sizeof(TaskWorker));
+    pthread_t *threads = calloc(nthreads, sizeof(pthread_t));
+    if(!pool.deques || !workers || !threads) {
+        free(pool.deques);
+        free(workers);
+        free(threads);
+        return 0;
+    }
+
+    for(int t = 0; t < nthreads; t++) {
+        pthread_mutex_init(&pool.deques[t].lock, NULL);
+        pool.deques[t].head = (int)((long long)count * t / nthreads);
+        pool.deques[t].tail = (int)((long long)count * (t + 1) / nthreads);
+        workers[t].pool = &pool;
+        workers[t].self = t;
+    }
+
+    // Le thread appelant sert de premier ouvrier
+    int started = 1;
+    for(int t = 1; t < nthreads; t++, started++)
+        if(pthread_create(&threads[t], NULL, worker_main, &workers[t]) != 0) break;
+    worker_main(&workers[0]);
+    for(int t = 1; t < started; t++)
+        pthread_join(threads[t], NULL);
+
+    for(int t = 0; t < nthreads; t++)
+        pthread_mutex_destroy(&pool.deques[t].lock);
+    free(pool.deques);
+    free(workers);
+    free(threads);
+    return 1;
+}
+
+int taskpool_default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
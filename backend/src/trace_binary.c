@@ -0,0 +1,114 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/trace_format.h"
+
+int trace_is_binary(const char *filename) {
+    char magic[8];
+    FILE *f = fopen(filename, "rb");
+    if (!f) return 0;
+    int ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, TRACE_MAGIC, 8) == 0;
+    fclose(f);
+    return ok;
+}
+
+static int trace_valid(const TraceHeader *h, size_t size) {
+    if (h->version != TRACE_VERSION || h->record_size != sizeof(TraceRecord)) return 0;
+    if (h->count > 0x7fffffff || h->io_count > 0xffffffff) return 0;
+    if (h->names_offset != sizeof(TraceHeader) + h->count * sizeof(TraceRecord) + h->io_count * sizeof(TraceIo))
+        return 0;
+    if (h->names_offset + h->names_size != size) return 0;
+    const char *names = (const char *)h + h->names_offset;
+    return h->names_size == 0 || names[h->names_size - 1] == '\0';
+}
+
+// E/S de l'enregistrement, recopiées dans l'arène de la table ; 0 si incohérentes
+static int load_io(const TraceHeader *h, const TraceRecord *rec, const TraceIo *io, ProcessTable *t, Process *proc) {
+    if (rec->nio == 0) return 1;
+    if ((uint64_t)rec->io + rec->nio > h->io_count) return 0;
+
+    IoBurst *dst = arena_alloc(&t->arena, sizeof(IoBurst) * rec->nio);
+    if (!dst) return 0;
+    long long cpu = 0;
+    for (uint32_t k = 0; k < rec->nio; k++) {
+        const TraceIo *src = &io[rec->io + k];
+        if (src->device < 0 || src->device >= MAX_DEVICES || src->length <= 0 || src->cpu <= 0) return 0;
+        dst[k].device = src->device;
+        dst[k].length = src->length;
+        dst[k].cpu = src->cpu;
+        cpu += src->cpu;
+    }
+    if (cpu > rec->burst) return 0;
+    proc->nio = (int)rec->nio;
+    proc->io = dst;
+    return 1;
+}
+
+// Les noms pointent directement dans la projection, qui vit aussi longtemps que la table
+int charger_trace_binaire(const char *filename, ProcessTable *t) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir %s\n", filename);
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        fprintf(stderr, "Erreur : trace binaire tronquée : %s\n", filename);
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Erreur : projection impossible de %s\n", filename);
+        return 0;
+    }
+
+    const TraceHeader *h = map;
+    if (!trace_valid(h, st.st_size)) {
+        fprintf(stderr, "Erreur : trace binaire invalide (version %u) : %s\n", h->version, filename);
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    if (!table_init(t, (int)h->count)) {
+        fprintf(stderr, "Erreur : mémoire insuffisante pour %llu processus\n", (unsigned long long)h->count);
+        munmap(map, st.st_size);
+        return 0;
+    }
+    t->map = map;
+    t->map_len = st.st_size;
+
+    const TraceRecord *rec = (const TraceRecord *)(h + 1);
+    const TraceIo *io = (const TraceIo *)(rec + h->count);
+    const char *names = (const char *)map + h->names_offset;
+    for (uint64_t k = 0; k < h->count; k++) {
+        Process proc;
+        memset(&proc, 0, sizeof(proc));
+        if (rec[k].name >= h->names_size || rec[k].arrival < 0 || rec[k].burst < 0
+            || !load_io(h, &rec[k], io, t, &proc)) {
+            fprintf(stderr, "%s : enregistrement %llu invalide, ignoré\n", filename, (unsigned long long)k);
+            continue;
+        }
+        Process *slot = table_push(t);
+        if (!slot) {
+            fprintf(stderr, "Erreur : mémoire insuffisante\n");
+            table_free(t);   // rend aussi la projection
+            return 0;
+        }
+        proc.id = slot->id;
+        proc.name = names + rec[k].name;
+        proc.arrival = rec[k].arrival;
+        proc.burst = rec[k].burst;
+        proc.priority = rec[k].priority;
+        proc.remaining = rec[k].burst;
+        *slot = proc;
+    }
+    return 1;
+}
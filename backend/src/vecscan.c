@@ -0,0 +1,79 @@
+#include "../include/vecscan.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define LANES 8
+typedef __m256i Vec;
+#define vec_load(p) _mm256_loadu_si256((const __m256i *)(p))
+#define vec_store(p, a) _mm256_storeu_si256((__m256i *)(p), a)
+#define vec_set1(x) _mm256_set1_epi32(x)
+#define vec_min(a, b) _mm256_min_epi32(a, b)
+#define vec_max(a, b) _mm256_max_epi32(a, b)
+#define vec_eq_mask(a, b) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))
+#elif defined(__SSE2__)
+#define LANES 4
+typedef __m128i Vec;
+#define vec_load(p) _mm_loadu_si128((const __m128i *)(p))
+#define vec_store(p, a) _mm_storeu_si128((__m128i *)(p), a)
+#define vec_set1(x) _mm_set1_epi32(x)
+// pminsd / pmaxsd datent de SSE4.1 : sélection par masque
+static inline Vec vec_min(Vec a, Vec b) {
+    Vec lt = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b));
+}
+static inline Vec vec_max(Vec a, Vec b) {
+    Vec gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+#define vec_eq_mask(a, b) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))
+#endif
+
+// Extremum de v (n >= 1) : minimum, ou maximum si max
+static int extremum(const int *v, int n, int max) {
+    int best = v[0], k = 0;
+#ifdef LANES
+    if(n >= LANES) {
+        int lanes[LANES];
+        Vec acc = vec_load(v);
+        for(k = LANES; k + LANES <= n; k += LANES)
+            acc = max ? vec_max(acc, vec_load(v + k)) : vec_min(acc, vec_load(v + k));
+        vec_store(lanes, acc);
+        for(int l = 0; l < LANES; l++)
+            if(max ? lanes[l] > best : lanes[l] < best) best = lanes[l];
+    }
+#endif
+    for(; k < n; k++)
+        if(max ? v[k] > best : v[k] < best) best = v[k];
+    return best;
+}
+
+// Première position de x dans v, qui l'y contient
+static int first_equal(const int *v, int n, int x) {
+    int k = 0;
+#ifdef LANES
+    Vec key = vec_set1(x);
+    for(; k + LANES <= n; k += LANES) {
+        int mask = vec_eq_mask(vec_load(v + k), key);
+        if(mask) {
+            while(!(mask & 1)) {
+                mask >>= 1;
+                k++;
+            }
+            return k;
+        }
+    }
+#endif
+    for(; k < n; k++)
+        if(v[k] == x) return k;
+    return -1;
+}
+
+int vec_argmin_int(const int *v, int n) {
+    return n > 0 ? first_equal(v, n, extremum(v, n, 0)) : -1;
+}
+
+int vec_argmax_int(const int *v, int n) {
+    return n > 0 ? first_equal(v, n, extremum(v, n, 1)) : -1;
+}
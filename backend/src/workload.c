@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "../include/workload.h"
+#include "../include/rng.h"
+
+#define MEAN_GAP      6.0      // burst moyen 5.5 : charge ~0.9
+#define HEAVY_GAP     3.3      // burst Pareto moyen ~3
+#define INTERACTIVE_GAP 15.0   // 5.5 rafales de 2.5 en moyenne par processus
+#define IO_MEAN       5.0      // E/S moyenne : chaque périphérique occupé à ~75 %
+#define MAX_IO        8
+#define MAX_BURST     100000
+#define MAX_RAFALE    64
+
+static const char *names[WL_COUNT] = { "uniform", "poisson", "heavy", "bursty", "interactive" };
+
+const char *workload_name(WorkloadKind kind) {
+    return kind >= 0 && kind < WL_COUNT ? names[kind] : "?";
+}
+
+int workload_kind(const char *name, WorkloadKind *kind) {
+    for(int k = 0; k < WL_COUNT; k++) {
+        if(strcmp(name, names[k]) == 0) {
+            *kind = (WorkloadKind)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static double next_unit(unsigned long long *state) {   // [0, 1)
+    return (rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int next_int(unsigned long long *state, int lo, int hi) {
+    return lo + (int)(rng_next(state) % (unsigned long long)(hi - lo + 1));
+}
+
+static double next_exp(unsigned long long *state, double mean) {
+    return -mean * log(1.0 - next_unit(state));
+}
+
+// Pareto d'indice 1.5 et de minimum 1, tronquée
+static int next_pareto(unsigned long long *state) {
+    double x = 1.0 / pow(1.0 - next_unit(state), 1.0 / 1.5);
+    return x >= MAX_BURST ? MAX_BURST : (int)ceil(x);
+}
+
+// De 1 à MAX_IO E/S, chacune suivie d'une rafale de 1 à 4 ; burst devient le total
+static int interactive_io(ProcessTable *t, Process *proc, unsigned long long *state) {
+    int nio = next_int(state, 1, MAX_IO);
+    IoBurst *io = arena_alloc(&t->arena, sizeof(IoBurst) * nio);
+    if(!io) return 0;
+
+    proc->burst = proc->remaining = next_int(state, 1, 4);
+    for(int k = 0; k < nio; k++) {
+        io[k].device = next_int(state, 0, 1);
+        io[k].length = (int)ceil(next_exp(state, IO_MEAN));
+        if(io[k].length < 1) io[k].length = 1;
+        io[k].cpu = next_int(state, 1, 4);
+        proc->burst += io[k].cpu;
+    }
+    proc->nio = nio;
+    proc->io = io;
+    return 1;
+}
+
+int workload_generate(ProcessTable *t, WorkloadKind kind, int n, unsigned long long seed) {
+    unsigned long long state = seed;
+    double clock = 0;
+    int rafale = 0;
+    char name[32];
+
+    if(!table_init(t, n)) return 0;
+
+    for(int i = 0; i < n; i++) {
+        switch(kind) {
+            case WL_UNIFORM:
+                if(i > 0) clock += next_int(&state, 0, 2 * (int)MEAN_GAP);
+                break;
+            case WL_POISSON:
+                if(i > 0) clock += next_exp(&state, MEAN_GAP);
+                break;
+            case WL_HEAVY:
+                if(i > 0) clock += next_exp(&state, HEAVY_GAP);
+                break;
+            case WL_INTERACTIVE:
+                if(i > 0) clock += next_exp(&state, INTERACTIVE_GAP);
+                break;
+            default:
+                // Une rafale de k arrivées simultanées, puis le silence correspondant
+                if(rafale == 0) {
+                    rafale = next_int(&state, 1, MAX_RAFALE);
+                    if(i > 0) clock += next_exp(&state, MEAN_GAP * MAX_RAFALE / 2);
+                }
+                rafale--;
+                break;
+        }
+
+        Process *proc = table_push(t);
+        if(!proc) {
+            table_free(t);
+            return 0;
+        }
+        snprintf(name, sizeof(name), "P%d", i + 1);
+        proc->name = pool_intern(&t->names, name, strlen(name));
+        if(!proc->name) {
+            table_free(t);
+            return 0;
+        }
+        proc->arrival = (int)clock;
+        proc->burst = kind == WL_HEAVY ? next_pareto(&state) : next_int(&state, 1, 10);
+        proc->priority = next_int(&state, 1, 10);
+        proc->remaining = proc->burst;
+        if(kind == WL_INTERACTIVE && !interactive_io(t, proc, &state)) {
+            table_free(t);
+            return 0;
+        }
+    }
+    return 1;
+}
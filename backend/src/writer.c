@@ -0,0 +1,67 @@
+#include <stdarg.h>
+#include "../include/writer.h"
+
+void writer_init(Writer *w, FILE *out) {
+    w->out = out;
+    w->len = 0;
+}
+
+void w_flush(Writer *w) {
+    if(w->len) fwrite(w->buf, 1, w->len, w->out);
+    w->len = 0;
+}
+
+void w_printf(Writer *w, const char *fmt, ...) {
+    va_list ap, again;
+    va_start(ap, fmt);
+    va_copy(again, ap);
+
+    size_t room = WRITER_BUF - w->len;
+    int n = vsnprintf(w->buf + w->len, room, fmt, ap);
+    if(n >= 0 && (size_t)n >= room) {
+        // Trop long pour la place restante : on vide et on recommence
+        w_flush(w);
+        if((size_t)n < WRITER_BUF) n = vsnprintf(w->buf, WRITER_BUF, fmt, again);
+        else {
+            vfprintf(w->out, fmt, again);
+            n = 0;
+        }
+    }
+    if(n > 0) w->len += n;
+
+    va_end(again);
+    va_end(ap);
+}
+
+void w_repeat(Writer *w, const char *s, long long count) {
+    size_t len = strlen(s);
+    for(long long k = 0; k < count; k++)
+        w_write(w, s, len);
+}
+
+static void pad(Writer *w, int count) {
+    for(; count > 0; count--) w_putc(w, ' ');
+}
+
+void w_int(Writer *w, long long v, int width) {
+    char digits[24];
+    int n = 0;
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+
+    do {
+        digits[sizeof(digits) - 1 - n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while(u);
+    if(v < 0) digits[sizeof(digits) - 1 - n++] = '-';
+
+    if(width > n) pad(w, width - n);
+    w_write(w, digits + sizeof(digits) - n, n);
+    if(-width > n) pad(w, -width - n);
+}
+
+void w_str(Writer *w, const char *s, int width) {
+    int n = (int)strlen(s);
+    if(width > n) pad(w, width - n);
+    w_write(w, s, n);
+    if(-width > n) pad(w, -width - n);
+}
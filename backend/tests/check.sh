@@ -0,0 +1,77 @@
+#!/bin/sh
+# Tests de non-régression (make check) : sorties comparées aux fichiers de tests/expected
+cd "$(dirname "$0")/.." || exit 1
+BIN=./ordonnanceur
+failed=0
+
+# expect NOM ENTRÉE ARGUMENTS... : la sortie standard doit être tests/expected/NOM.out
+expect() {
+    name=$1 input=$2
+    shift 2
+    printf "$input" | $BIN "$@" > "tests/$name.actual" 2>/dev/null
+    if cmp -s "tests/$name.actual" "tests/expected/$name.out"; then
+        rm -f "tests/$name.actual"
+        echo "ok    $name"
+    else
+        echo "ÉCHEC $name (voir tests/$name.actual)"
+        failed=1
+    fi
+}
+
+# Arrivée pendant la commutation : la tranche multilevel ne doit pas devenir négative
+expect multilevel_switch_cost '4\n2\n' --format=json --switch-cost=1 tests/traces/multilevel_switch.txt
+expect multilevel_switch_warmup '4\n2\n' --format=json --switch-cost=2 --warmup=1 tests/traces/multilevel_switch.txt
+
+# En-tête rejeté (aucun choix, quantum non entier) : son corps est sauté, la requête suivante est lue
+expect serve_bad_header 'SIMULATE a 2 2 \nP1 0 3 1\nP2 1 2 1\nSIMULATE b 2 abc 1\nP1 0 3 1\nP2 1 2 1\nSIMULATE c 1 2 1\nP1 0 3 1\nQUIT\n' --serve
+
+# Fin de chaque processus, "pid fin" par ligne, en JSON (menu) ou JSON Lines (flux)
+finishes() {
+    tr '{' '\n' | sed -n 's/^"pid":\([0-9]*\),"name".*"finish":\([0-9-]*\).*/\1 \2/p' | sort -n
+}
+
+# same_as_batch POLITIQUE QUANTUM ARGUMENTS... : le flux doit finir chaque processus comme le menu
+same_as_batch() {
+    policy=$1 quantum=$2
+    shift 2
+    name="stream_$policy$(echo "$*" | tr -d ' -=')"
+    printf "$policy\n$quantum\n" | $BIN --format=json "$@" tests/traces/ties.txt 2>/dev/null | finishes > "tests/$name.batch"
+    $BIN --format=json --stream=$policy --quantum=$quantum "$@" < tests/traces/ties.txt 2>/dev/null | finishes \
+        > "tests/$name.actual"
+    if [ -s "tests/$name.batch" ] && cmp -s "tests/$name.batch" "tests/$name.actual"; then
+        rm -f "tests/$name.batch" "tests/$name.actual"
+        echo "ok    $name"
+    else
+        echo "ÉCHEC $name (voir tests/$name.batch et tests/$name.actual)"
+        failed=1
+    fi
+}
+
+# Cases recyclées par le flux : les égalités se tranchent par admission, comme dans le menu
+for policy in 1 2 3 4 5 6 7 8 9 11; do
+    same_as_batch $policy 3
+    same_as_batch $policy 3 --switch-cost=1 --warmup=2
+done
+
+# resumed_as_fresh POLITIQUES : en mode serveur, la requête modifiée reprend de la
+# précédente (trace saturée : points de reprise en pleine charge) et doit donner
+# le même résultat que simulée seule
+resumed_as_fresh() {
+    name="resume_$(echo "$1" | tr , _)"
+    n=$(wc -l < tests/traces/saturated.txt)
+    sed '390s/^\(P390 [0-9]*\) \([0-9]*\)/\1 2\2/' tests/traces/saturated.txt > "tests/$name.trace"
+    { echo "SIMULATE b $n 2 $1"; cat "tests/$name.trace"; echo QUIT; } | $BIN --serve > "tests/$name.batch" 2>/dev/null
+    { echo "SIMULATE a $n 2 $1"; cat tests/traces/saturated.txt; echo "SIMULATE b $n 2 $1"; cat "tests/$name.trace"
+      echo QUIT; } | $BIN --serve 2>/dev/null | sed -n 2p > "tests/$name.actual"
+    if [ -s "tests/$name.batch" ] && cmp -s "tests/$name.batch" "tests/$name.actual"; then
+        rm -f "tests/$name.trace" "tests/$name.batch" "tests/$name.actual"
+        echo "ok    $name"
+    else
+        echo "ÉCHEC $name (voir tests/$name.batch et tests/$name.actual)"
+        failed=1
+    fi
+}
+
+resumed_as_fresh 1,2,3,4,5,6,7,8,9,10,11
+
+exit $failed
@@ -0,0 +1,172 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "process.h"
+#include "scheduler.h"
+#include "workload.h"
+
+#define BENCH_QUANTUM 4
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// ru_maxrss ne redescend jamais : c'est le pic du processus jusqu'ici
+static long peak_rss_kb(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+typedef struct {
+    int ok;
+    long long events;
+    int segments;
+    double sim, render;
+    long rss;
+} BenchRun;
+
+static void measure(const Policy *pol, ProcessTable *table, BenchRun *b) {
+    FILE *sink = fopen("/dev/null", "w");
+    SchedRun r;
+
+    sched_run_prepare(&r, pol->id, table, BENCH_QUANTUM, 0);
+    double t0 = now_ms();
+    sched_run_simulate(&r);
+    double t1 = now_ms();
+    if (r.ok && sink) {
+        sched_run_render(&r, FORMAT_JSON, sink);
+        fflush(sink);
+    }
+    double t2 = now_ms();
+
+    b->ok = r.ok && sink;
+    b->events = r.e.events;
+    b->segments = r.e.sched.count;
+    b->sim = t1 - t0;
+    b->render = t2 - t1;
+    b->rss = peak_rss_kb();
+    sched_run_release(&r);
+    if (sink) fclose(sink);
+}
+
+/*
+ * Une exécution par processus fils : son pic de mémoire part de celle du
+ * parent (table comprise) et ne garde rien des politiques précédentes.
+ */
+static int measure_in_child(const Policy *pol, ProcessTable *table, BenchRun *b) {
+    int fd[2];
+    if (pipe(fd) != 0) return 0;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fd[0]);
+        close(fd[1]);
+        return 0;
+    }
+    if (pid == 0) {
+        close(fd[0]);
+        measure(pol, table, b);
+        _exit(write(fd[1], b, sizeof(*b)) == (ssize_t)sizeof(*b) ? 0 : 1);
+    }
+
+    close(fd[1]);
+    size_t got = 0;
+    ssize_t k;
+    while (got < sizeof(*b) && (k = read(fd[0], (char *)b + got, sizeof(*b) - got)) > 0)
+        got += k;
+    close(fd[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    return got == sizeof(*b);
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [--max=N] [--budget=SECONDES] [--seed=S] [--out=resultats.csv]\n", prog);
+}
+
+/*
+ * Chaque politique est mesurée sur chaque charge synthétique, n = 10, 100...
+ * max. Une politique qui dépasse le budget sur une taille n'est plus lancée
+ * sur les tailles suivantes de la même charge.
+ */
+int main(int argc, char *argv[]) {
+    int max = 1000000;
+    double budget_ms = 10000;
+    unsigned long long seed = 1;
+    const char *out_name = "bench_results.csv";
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--max=", 6) == 0) max = atoi(argv[i] + 6);
+        else if (strncmp(argv[i], "--budget=", 9) == 0) budget_ms = atof(argv[i] + 9) * 1000;
+        else if (strncmp(argv[i], "--seed=", 7) == 0) seed = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--out=", 6) == 0) out_name = argv[i] + 6;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *csv = fopen(out_name, "w");
+    if (!csv) {
+        fprintf(stderr, "Erreur : impossible de créer %s\n", out_name);
+        return 1;
+    }
+    fprintf(csv, "workload,n,policy,events,segments,simulate_ms,render_ms,events_per_sec,peak_rss_kb\n");
+
+    int npol;
+    const Policy *pols = policy_list(&npol);
+
+    printf("%-8s %8s %-24s %10s %10s %10s %12s %10s\n",
+           "Workload", "n", "Policy", "Events", "Sim ms", "Render ms", "Events/s", "RSS KiB");
+
+    for (int kind = 0; kind < WL_COUNT; kind++) {
+        int skipped[npol];
+        memset(skipped, 0, sizeof(skipped));
+
+        for (int n = 10; n <= max; n *= 10) {
+            ProcessTable table;
+            if (!workload_generate(&table, kind, n, seed)) {
+                fprintf(stderr, "Erreur : mémoire insuffisante (n = %d)\n", n);
+                return 1;
+            }
+
+            for (int k = 0; k < npol; k++) {
+                if (skipped[k]) {
+                    printf("%-8s %8d %-24s %10s\n", workload_name(kind), n, pols[k].name, "(budget)");
+                    continue;
+                }
+
+                BenchRun b;
+                if (!measure_in_child(&pols[k], &table, &b) || !b.ok) {
+                    printf("%-8s %8d %-24s %10s\n", workload_name(kind), n, pols[k].name, "(mémoire)");
+                    skipped[k] = 1;
+                    continue;
+                }
+
+                double rate = b.sim > 0 ? b.events / (b.sim / 1000) : 0;
+                printf("%-8s %8d %-24s %10lld %10.2f %10.2f %12.0f %10ld\n",
+                       workload_name(kind), n, pols[k].name, b.events, b.sim, b.render, rate, b.rss);
+                fprintf(csv, "%s,%d,\"%s\",%lld,%d,%.3f,%.3f,%.0f,%ld\n",
+                        workload_name(kind), n, pols[k].name, b.events, b.segments,
+                        b.sim, b.render, rate, b.rss);
+                fflush(stdout);
+
+                if (b.sim > budget_ms) skipped[k] = 1;
+            }
+            table_free(&table);
+            if (n > max / 10) break;
+        }
+    }
+
+    fclose(csv);
+    printf("\nRésultats : %s\n", out_name);
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "schedule_log.h"
+#include "scheduler.h"
+#include "render.h"
+
+static void usage(const char *prog) {
+    printf("Usage: %s [--format=text|json] journal.osched info\n", prog);
+    printf("       %s [--format=text|json] journal.osched at T\n", prog);
+    printf("       %s [--format=text|json] journal.osched process PID|NOM\n", prog);
+    printf("       %s [--format=text|json] journal.osched util A B\n", prog);
+    printf("       %s [--format=text|json] journal.osched window A B\n", prog);
+}
+
+static int parse_time(const char *s, long long *t) {
+    char *end;
+    *t = strtoll(s, &end, 10);
+    return end != s && *end == '\0';
+}
+
+static void corrupt(const char *filename) {
+    fprintf(stderr, "Erreur : journal corrompu : %s\n", filename);
+}
+
+static void json_segment(Writer *w, const SchedLog *l, const LogEvent *ev, int first) {
+    if(!first) w_putc(w, ',');
+    w_printf(w, "{\"pid\":%d,\"process\":", l->proc[ev->proc].id);
+    w_json_string(w, log_name(l, ev->proc));
+    w_printf(w, ",\"start\":%lld,\"end\":%lld,\"level\":%d,\"cpu\":%d}", ev->time, ev->end, ev->level, ev->cpu);
+}
+
+static int info(const SchedLog *l, int json, Writer *w) {
+    const SchedLogHeader *h = l->h;
+    const Policy *pol = find_policy(h->policy);
+    const char *name = pol ? pol->name : "?";
+    double per_segment = h->nsegments > 0 ? (double)h->events_size / h->nsegments : 0;
+
+    if(json) {
+        w_puts(w, "{\"policy\":");
+        w_json_string(w, name);
+        w_printf(w, ",\"quantum\":%d,\"cpus\":%u,\"processes\":%llu,\"segments\":%llu,\"events\":%llu,"
+                 "\"makespan\":%lld,\"bytes\":%llu,\"event_bytes\":%llu,\"blocks\":%llu}\n", h->quantum, h->ncpu,
+                 (unsigned long long)h->nproc, (unsigned long long)h->nsegments, (unsigned long long)h->nevents,
+                 (long long)h->makespan, (unsigned long long)l->len, (unsigned long long)h->events_size,
+                 (unsigned long long)l->nindex);
+        return 1;
+    }
+    w_printf(w, "Policy: %s", name);
+    if(pol && pol->uses_quantum) w_printf(w, " (Q=%d)", h->quantum);
+    w_printf(w, "\nCPUs: %u, processes: %llu, segments: %llu, events: %llu, makespan: %lld\n", h->ncpu,
+             (unsigned long long)h->nproc, (unsigned long long)h->nsegments, (unsigned long long)h->nevents,
+             (long long)h->makespan);
+    w_printf(w, "File: %llu bytes, events: %llu bytes (%.2f per segment), index: %llu blocks of %u events\n",
+             (unsigned long long)l->len, (unsigned long long)h->events_size, per_segment,
+             (unsigned long long)l->nindex, h->block);
+    return 1;
+}
+
+// Processus en cours sur chaque CPU à la date t
+static int at(const SchedLog *l, long long t, int json, Writer *w) {
+    LogEvent *running = calloc(l->h->ncpu, sizeof(LogEvent));
+    LogCursor c;
+    LogEvent ev;
+    int status;
+
+    if(!running) return 0;
+    for(uint32_t k = 0; k < l->h->ncpu; k++) running[k].proc = -1;
+    log_seek(&c, l, log_block_from(l, t));
+    while((status = log_next(&c, &ev)) > 0 && ev.time <= t)
+        if(ev.kind == LOG_SEGMENT && ev.end > t) running[ev.cpu] = ev;
+
+    if(json) w_printf(w, "{\"time\":%lld,\"running\":[", t);
+    else w_printf(w, "t=%lld\n", t);
+    for(uint32_t k = 0; k < l->h->ncpu; k++) {
+        if(json) {
+            if(running[k].proc < 0) w_printf(w, "%s{\"cpu\":%u,\"pid\":null}", k > 0 ? "," : "", k);
+            else json_segment(w, l, &running[k], k == 0);
+        } else if(running[k].proc < 0) {
+            w_printf(w, "CPU %u: idle\n", k);
+        } else {
+            w_printf(w, "CPU %u: %s (pid %d) [%lld, %lld) level %d\n", k, log_name(l, running[k].proc),
+                     l->proc[running[k].proc].id, running[k].time, running[k].end, running[k].level);
+        }
+    }
+    if(json) w_puts(w, "]}\n");
+    free(running);
+    return status >= 0;
+}
+
+// Rang dans la table : numéro de processus, sinon nom
+static int find_process(const SchedLog *l, const char *key) {
+    char *end;
+    long id = strtol(key, &end, 10);
+    for(uint64_t i = 0; i < l->h->nproc; i++)
+        if((end != key && *end == '\0' && l->proc[i].id == id) || strcmp(log_name(l, (int)i), key) == 0)
+            return (int)i;
+    return -1;
+}
+
+// Ses segments sont entre son arrivée et sa fin : seule cette plage est décodée
+static int process(const SchedLog *l, int i, int json, Writer *w) {
+    const SchedLogProc *p = &l->proc[i];
+    long long last = p->finish >= 0 ? p->finish : LLONG_MAX, ran = 0;
+    LogCursor c;
+    LogEvent ev;
+    int status, count = 0;
+
+    if(json) {
+        w_printf(w, "{\"pid\":%d,\"name\":", p->id);
+        w_json_string(w, log_name(l, i));
+        w_printf(w, ",\"arrival\":%d,\"burst\":%d,\"priority\":%d,\"finish\":%lld,\"segments\":[", p->arrival,
+                 p->burst, p->priority, (long long)p->finish);
+    } else {
+        w_printf(w, "%s (pid %d): arrival %d, burst %d, priority %d, finish %lld\n", log_name(l, i), p->id,
+                 p->arrival, p->burst, p->priority, (long long)p->finish);
+        w_printf(w, "%-10s %-10s %-5s %-5s\n", "Start", "End", "CPU", "Level");
+    }
+    log_seek(&c, l, log_block_from(l, p->arrival));
+    while((status = log_next(&c, &ev)) > 0 && ev.time <= last) {
+        if(ev.kind != LOG_SEGMENT || ev.proc != i) continue;
+        if(json) json_segment(w, l, &ev, count == 0);
+        else w_printf(w, "%-10lld %-10lld %-5d %-5d\n", ev.time, ev.end, ev.cpu, ev.level);
+        ran += ev.end - ev.time;
+        count++;
+    }
+    if(json) w_printf(w, "],\"ran\":%lld}\n", ran);
+    else w_printf(w, "Segments: %d, ran: %lld\n", count, ran);
+    return status >= 0;
+}
+
+// Segments qui recoupent [a, b), coupés aux bornes pour l'utilisation
+static int window(const SchedLog *l, long long a, long long b, int util, int json, Writer *w) {
+    long long *busy = calloc(l->h->ncpu, sizeof(long long));
+    LogCursor c;
+    LogEvent ev;
+    int status, count = 0;
+
+    if(!busy) return 0;
+    if(!util) {
+        if(json) w_printf(w, "{\"from\":%lld,\"to\":%lld,\"segments\":[", a, b);
+        else w_printf(w, "%-5s %-10s %-8s %-10s %-10s %-5s\n", "CPU", "Process", "PID", "Start", "End", "Level");
+    }
+    log_seek(&c, l, log_block_from(l, a));
+    while((status = log_next(&c, &ev)) > 0 && ev.time < b) {
+        if(ev.kind != LOG_SEGMENT || ev.end <= a) continue;
+        busy[ev.cpu] += (ev.end < b ? ev.end : b) - (ev.time > a ? ev.time : a);
+        if(util) continue;
+        if(json) json_segment(w, l, &ev, count == 0);
+        else w_printf(w, "%-5d %-10s %-8d %-10lld %-10lld %-5d\n", ev.cpu, log_name(l, ev.proc),
+                      l->proc[ev.proc].id, ev.time, ev.end, ev.level);
+        count++;
+    }
+
+    if(!util) {
+        if(json) w_puts(w, "]}\n");
+        else w_printf(w, "Segments: %d\n", count);
+    } else {
+        long long total = 0;
+        for(uint32_t k = 0; k < l->h->ncpu; k++) total += busy[k];
+        double span = (double)(b - a) * l->h->ncpu;
+        if(json) w_printf(w, "{\"from\":%lld,\"to\":%lld,\"busy\":%lld,\"utilization\":%.4f,\"cpus\":[", a, b, total,
+                          total / span);
+        else w_printf(w, "Utilization [%lld, %lld): %.2f%% (busy %lld)\n", a, b, total / span * 100, total);
+        for(uint32_t k = 0; k < l->h->ncpu; k++) {
+            if(json) w_printf(w, "%s%.4f", k > 0 ? "," : "", busy[k] / (double)(b - a));
+            else if(l->h->ncpu > 1) w_printf(w, "CPU %u: %.2f%%\n", k, busy[k] * 100.0 / (b - a));
+        }
+        if(json) w_puts(w, "]}\n");
+    }
+    free(busy);
+    return status >= 0;
+}
+
+/*
+ * Requêtes sur un journal écrit par ordonnanceur --schedule-log : l'index
+ * donne le bloc de départ, seuls les événements de la plage sont décodés.
+ */
+int main(int argc, char *argv[]) {
+    int json = 0, arg = 1;
+    if(arg < argc && strncmp(argv[arg], "--format=", 9) == 0) {
+        json = strcmp(argv[arg] + 9, "json") == 0;
+        arg++;
+    }
+    if(argc - arg < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char *filename = argv[arg], *cmd = argv[arg + 1];
+    char **rest = argv + arg + 2;
+    int nrest = argc - arg - 2;
+    SchedLog l;
+    if(!schedule_log_open(&l, filename)) {
+        printf("Erreur : journal d'ordonnancement illisible : %s\n", filename);
+        return 1;
+    }
+
+    Writer *w = malloc(sizeof(Writer));
+    long long a, b;
+    int ok = -1;
+    if(!w) {
+        schedule_log_close(&l);
+        return 1;
+    }
+    writer_init(w, stdout);
+
+    if(strcmp(cmd, "info") == 0 && nrest == 0) {
+        ok = info(&l, json, w);
+    } else if(strcmp(cmd, "at") == 0 && nrest == 1 && parse_time(rest[0], &a)) {
+        ok = at(&l, a, json, w);
+    } else if(strcmp(cmd, "process") == 0 && nrest == 1) {
+        int i = find_process(&l, rest[0]);
+        if(i < 0) printf("Processus inconnu : %s\n", rest[0]);
+        else ok = process(&l, i, json, w);
+    } else if((strcmp(cmd, "util") == 0 || strcmp(cmd, "window") == 0) && nrest == 2 && parse_time(rest[0], &a)
+              && parse_time(rest[1], &b) && a < b) {
+        ok = window(&l, a, b, strcmp(cmd, "util") == 0, json, w);
+    } else {
+        usage(argv[0]);
+    }
+
+    w_flush(w);
+    if(ok == 0) corrupt(filename);
+    free(w);
+    schedule_log_close(&l);
+    return ok == 1 ? 0 : 1;
+}
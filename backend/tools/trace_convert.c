@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "trace_reader.h"
+#include "trace_format.h"
+
+// Convertit une trace texte (nom arrivée burst priorité [E/S rafale]...) en trace binaire
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s fichier_processus.txt sortie.bin\n", argv[0]);
+        return 1;
+    }
+
+    TraceReader r;
+    if (!trace_open(&r, argv[1])) {
+        printf("Erreur : impossible d'ouvrir %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[2], "wb");
+    if (!out) {
+        printf("Erreur : impossible de créer %s\n", argv[2]);
+        trace_close(&r);
+        return 1;
+    }
+
+    Arena arena;
+    StringPool names;
+    if (!arena_init(&arena, 1 << 20) || !pool_init(&names, &arena, 1024)) {
+        printf("Erreur : mémoire insuffisante\n");
+        return 1;
+    }
+
+    // Les enregistrements sont écrits au fil de l'eau, l'en-tête est réécrit à la fin
+    TraceHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    h.version = TRACE_VERSION;
+    h.record_size = sizeof(TraceRecord);
+    fwrite(&h, sizeof(h), 1, out);
+
+    uint32_t *offsets = NULL;
+    int offsets_cap = 0, seen = 0;
+    // Les E/S suivent tous les enregistrements : gardées en mémoire jusqu'à la fin
+    TraceIo *io = NULL;
+    uint64_t io_cap = 0;
+    Process proc;
+    while (trace_next(&r, &names, &proc)) {
+        int id = pool_id(&names, proc.name, strlen(proc.name));
+        if (id >= offsets_cap) {
+            offsets_cap = offsets_cap ? offsets_cap * 2 : 1024;
+            offsets = realloc(offsets, sizeof(uint32_t) * offsets_cap);
+        }
+        if (id < 0 || !offsets) {
+            printf("Erreur : mémoire insuffisante\n");
+            return 1;
+        }
+        if (id == seen) {
+            offsets[id] = (uint32_t)h.names_size;
+            h.names_size += strlen(proc.name) + 1;
+            seen++;
+        }
+
+        if (h.io_count + proc.nio > io_cap) {
+            while (h.io_count + proc.nio > io_cap) io_cap = io_cap ? io_cap * 2 : 1024;
+            TraceIo *bigger = realloc(io, sizeof(TraceIo) * io_cap);
+            if (!bigger) {
+                printf("Erreur : mémoire insuffisante\n");
+                return 1;
+            }
+            io = bigger;
+        }
+        TraceRecord rec = { proc.arrival, proc.burst, proc.priority, offsets[id], (uint32_t)h.io_count, (uint32_t)proc.nio };
+        for (int k = 0; k < proc.nio; k++) {
+            TraceIo one = { proc.io[k].device, proc.io[k].length, proc.io[k].cpu };
+            io[h.io_count++] = one;
+        }
+        fwrite(&rec, sizeof(rec), 1, out);
+        h.count++;
+    }
+
+    if (h.io_count) fwrite(io, sizeof(TraceIo), h.io_count, out);
+    for (int id = 0; id < names.count; id++)
+        fwrite(names.strings[id], strlen(names.strings[id]) + 1, 1, out);
+
+    h.names_offset = sizeof(TraceHeader) + h.count * sizeof(TraceRecord) + h.io_count * sizeof(TraceIo);
+    fseek(out, 0, SEEK_SET);
+    fwrite(&h, sizeof(h), 1, out);
+
+    int ok = !ferror(out);
+    fclose(out);
+    trace_close(&r);
+    free(offsets);
+    free(io);
+    arena_free(&arena);
+
+    if (!ok) {
+        printf("Erreur : écriture de %s échouée\n", argv[2]);
+        return 1;
+    }
+    printf("%llu processus, %d noms distincts -> %s\n", (unsigned long long)h.count, names.count, argv[2]);
+    return r.errors > 0 ? 2 : 0;
+}
@@ -0,0 +1,34 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "process.h"
+#include "workload.h"
+
+// Écrit une charge synthétique au format texte (nom arrivée burst priorité [E/S rafale]...)
+int main(int argc, char *argv[]) {
+    WorkloadKind kind;
+    if (argc < 3 || !workload_kind(argv[1], &kind) || atoi(argv[2]) <= 0) {
+        printf("Usage: %s uniform|poisson|heavy|bursty|interactive nb_processus [graine]\n", argv[0]);
+        return 1;
+    }
+
+    int n = atoi(argv[2]);
+    unsigned long long seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 1;
+
+    ProcessTable table;
+    if (!workload_generate(&table, kind, n, seed)) {
+        fprintf(stderr, "Erreur : mémoire insuffisante\n");
+        return 1;
+    }
+
+    printf("# %s, %d processus, graine %llu\n", workload_name(kind), n, seed);
+    for (int i = 0; i < table.n; i++) {
+        const Process *p = &table.p[i];
+        printf("%s %d %d %d", p->name, p->arrival, process_first_burst(p), p->priority);
+        for (int k = 0; k < p->nio; k++)
+            printf(" %d@%d %d", p->io[k].length, p->io[k].device, p->io[k].cpu);
+        putchar('\n');
+    }
+
+    table_free(&table);
+    return 0;
+}